@@ -0,0 +1,354 @@
+/*
+ * Microbenchmarks de l'allocateur. Le programme n'utilise que malloc(), calloc(), realloc() et free() :
+ * le même binaire mesure l'allocateur de la glibc, ou libmy_secmalloc.so chargée avec LD_PRELOAD (make bench).
+ *
+ * Utilisation : bench/bench [nom de l'allocateur] [facteur de répétition]
+ *
+ * Les résultats sont écrits sur la sortie standard sous la forme d'un objet JSON. Chaque mesure porte sur un lot
+ * de BATCH_SIZE opérations : ns_per_op est la durée moyenne d'une opération, et p50, p90 et p99 sont les
+ * percentiles de la durée moyenne d'une opération au sein d'un lot.
+ */
+#define _GNU_SOURCE // Pour dladdr()
+#include <stdio.h> // printf()
+#include <stdlib.h> // malloc(), calloc(), realloc(), free(), qsort(), strtoul()
+#include <string.h> // memset()
+#include <pthread.h> // pthread_create(), pthread_join(), pthread_mutex_ ..., pthread_cond_ ...
+#include <time.h> // clock_gettime()
+#include <dlfcn.h> // dladdr()
+
+#define BATCH_SIZE 32
+#define QUEUE_SIZE 1024 // Nombre de pointeurs de la file partagée par les producteurs et les consommateurs
+
+struct samples {
+	double *values; // Durée moyenne d'une opération (en nanosecondes) de chaque lot
+	size_t values_nb;
+	size_t capacity;
+	size_t ops_nb;
+	double total_time; // En nanosecondes
+};
+
+// Générateur pseudo-aléatoire xorshift : rand() prend un verrou, qui fausserait les mesures multithread
+struct random_state {
+	unsigned long state;
+};
+
+size_t repeat = 1;
+int first_result = 1;
+
+double now_ns() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
+
+unsigned long random_next(struct random_state *random_state) {
+	random_state->state ^= random_state->state << 13;
+	random_state->state ^= random_state->state >> 7;
+	random_state->state ^= random_state->state << 17;
+	return random_state->state;
+}
+
+// Taille comprise entre min_size et max_size, distribuée uniformément
+size_t random_size(struct random_state *random_state, size_t min_size, size_t max_size) {
+	return min_size + random_next(random_state) % (max_size - min_size + 1);
+}
+
+// Taille comprise entre 8 octets et 64 Kio, dont le logarithme est distribué uniformément :
+// les petites allocations sont les plus fréquentes
+size_t random_mixed_size(struct random_state *random_state) {
+	size_t size_class = 3 + random_next(random_state) % 14;
+	return random_size(random_state, (size_t) 1 << size_class, ((size_t) 1 << (size_class + 1)) - 1);
+}
+
+void samples_init(struct samples *samples, size_t capacity) {
+	samples->values = malloc(capacity * sizeof(double));
+	samples->values_nb = 0;
+	samples->capacity = capacity;
+	samples->ops_nb = 0;
+	samples->total_time = 0;
+}
+
+void samples_add(struct samples *samples, double batch_time, size_t batch_ops_nb) {
+	if (samples->values_nb < samples->capacity)
+		samples->values[samples->values_nb++] = batch_time / (double) batch_ops_nb;
+	samples->ops_nb += batch_ops_nb;
+	samples->total_time += batch_time;
+}
+
+int compare_doubles(const void *a, const void *b) {
+	double double_a = *((const double *) a), double_b = *((const double *) b);
+	return (double_a > double_b) - (double_a < double_b);
+}
+
+double percentile(struct samples *samples, double p) {
+	if (samples->values_nb == 0)
+		return 0;
+	return samples->values[(size_t) (p * (double) (samples->values_nb - 1))];
+}
+
+void report(const char *name, struct samples *samples, const char *parameter_name, size_t parameter) {
+	qsort(samples->values, samples->values_nb, sizeof(double), compare_doubles);
+
+	printf("%s\n    {\"name\": \"%s\"", first_result ? "" : ",", name);
+	if (parameter_name != NULL)
+		printf(", \"%s\": %lu", parameter_name, parameter);
+	printf(", \"ops\": %lu, \"ns_per_op\": %.1f, \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f}",
+			samples->ops_nb, samples->total_time / (double) samples->ops_nb,
+			percentile(samples, 0.5), percentile(samples, 0.9), percentile(samples, 0.99));
+	fflush(stdout);
+
+	first_result = 0;
+	free(samples->values);
+}
+
+/* ****************************************************************** */
+/* ************************** MESURES ******************************* */
+/* ****************************************************************** */
+
+// Paires malloc()/free() immédiates, tailles comprises entre min_size et max_size (max_size = 0 : tailles mixtes)
+void bench_malloc_free(const char *name, size_t min_size, size_t max_size) {
+	size_t batches_nb = 20000 * repeat;
+	struct random_state random_state = { 42 };
+	struct samples samples;
+	samples_init(&samples, batches_nb);
+
+	size_t sizes[BATCH_SIZE];
+	void *ptrs[BATCH_SIZE];
+	for (size_t i = 0; i < batches_nb; i++) {
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			sizes[j] = (max_size == 0) ? random_mixed_size(&random_state) : random_size(&random_state, min_size, max_size);
+
+		double start_time = now_ns();
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			ptrs[j] = malloc(sizes[j]);
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			free(ptrs[j]);
+		samples_add(&samples, now_ns() - start_time, 2 * BATCH_SIZE);
+	}
+
+	report(name, &samples, NULL, 0);
+}
+
+void bench_calloc_free() {
+	size_t batches_nb = 20000 * repeat;
+	struct random_state random_state = { 43 };
+	struct samples samples;
+	samples_init(&samples, batches_nb);
+
+	size_t sizes[BATCH_SIZE];
+	void *ptrs[BATCH_SIZE];
+	for (size_t i = 0; i < batches_nb; i++) {
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			sizes[j] = random_size(&random_state, 8, 4096);
+
+		double start_time = now_ns();
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			ptrs[j] = calloc(1, sizes[j]);
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			free(ptrs[j]);
+		samples_add(&samples, now_ns() - start_time, 2 * BATCH_SIZE);
+	}
+
+	report("calloc_free", &samples, NULL, 0);
+}
+
+// Chaînes de realloc() : un tampon grandit de 16 octets à 64 Kio par pas de 16 octets (comme un tableau dynamique
+// élargi élément par élément), en présence d'autres blocs alloués entre deux agrandissements
+void bench_realloc_chain() {
+	size_t chains_nb = 20 * repeat;
+	struct samples samples;
+	samples_init(&samples, chains_nb * 4096 / BATCH_SIZE);
+
+	void *others[4096 / BATCH_SIZE];
+	for (size_t i = 0; i < chains_nb; i++) {
+		char *ptr = NULL;
+		size_t size = 16;
+		for (size_t j = 0; j < 4096 / BATCH_SIZE; j++) {
+			double start_time = now_ns();
+			for (size_t k = 0; k < BATCH_SIZE; k++, size += 16)
+				ptr = realloc(ptr, size);
+			samples_add(&samples, now_ns() - start_time, BATCH_SIZE);
+
+			ptr[size - 17] = 1;
+			others[j] = malloc(32);
+		}
+
+		free(ptr);
+		for (size_t j = 0; j < 4096 / BATCH_SIZE; j++)
+			free(others[j]);
+	}
+
+	report("realloc_chain", &samples, NULL, 0);
+}
+
+// Latence d'une paire free()/malloc() (remplacement d'un bloc choisi au hasard) en fonction du nombre de blocs vivants
+void bench_heap_scaling(size_t live_blocks_nb) {
+	size_t batches_nb = 10000 * repeat;
+	struct random_state random_state = { 44 };
+	struct samples samples;
+	samples_init(&samples, batches_nb);
+
+	void **live_blocks = malloc(live_blocks_nb * sizeof(void *));
+	for (size_t i = 0; i < live_blocks_nb; i++)
+		live_blocks[i] = malloc(random_size(&random_state, 16, 512));
+
+	size_t indexes[BATCH_SIZE], sizes[BATCH_SIZE];
+	for (size_t i = 0; i < batches_nb; i++) {
+		for (size_t j = 0; j < BATCH_SIZE; j++) {
+			indexes[j] = random_next(&random_state) % live_blocks_nb;
+			sizes[j] = random_size(&random_state, 16, 512);
+		}
+
+		double start_time = now_ns();
+		for (size_t j = 0; j < BATCH_SIZE; j++) {
+			free(live_blocks[indexes[j]]);
+			live_blocks[indexes[j]] = malloc(sizes[j]);
+		}
+		samples_add(&samples, now_ns() - start_time, 2 * BATCH_SIZE);
+	}
+
+	for (size_t i = 0; i < live_blocks_nb; i++)
+		free(live_blocks[i]);
+	free(live_blocks);
+
+	report("heap_scaling", &samples, "live_blocks", live_blocks_nb);
+}
+
+// Producteurs et consommateurs : les blocs alloués par les producteurs sont libérés par les consommateurs
+// (libérations par un autre thread que celui qui a alloué)
+struct queue {
+	void *ptrs[QUEUE_SIZE];
+	size_t head; // Nombre total de pointeurs ajoutés
+	size_t tail; // Nombre total de pointeurs retirés
+	size_t producers_nb; // Producteurs en cours d'exécution
+	pthread_mutex_t mutex;
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+};
+
+struct worker {
+	struct queue *queue;
+	size_t blocks_nb; // Nombre de blocs alloués par chaque producteur
+	unsigned long seed;
+	struct samples samples; // Durée de chaque lot d'allocations (producteurs) ou de libérations (consommateurs)
+};
+
+void *producer(void *arg) {
+	struct worker *worker = arg;
+	struct queue *queue = worker->queue;
+	struct random_state random_state = { worker->seed };
+
+	void *ptrs[BATCH_SIZE];
+	for (size_t i = 0; i < worker->blocks_nb / BATCH_SIZE; i++) {
+		double start_time = now_ns();
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+			ptrs[j] = malloc(random_size(&random_state, 16, 1024));
+		samples_add(&(worker->samples), now_ns() - start_time, BATCH_SIZE);
+
+		pthread_mutex_lock(&(queue->mutex));
+		for (size_t j = 0; j < BATCH_SIZE; j++) {
+			while (queue->head - queue->tail == QUEUE_SIZE)
+				pthread_cond_wait(&(queue->not_full), &(queue->mutex));
+			queue->ptrs[queue->head++ % QUEUE_SIZE] = ptrs[j];
+		}
+		pthread_cond_broadcast(&(queue->not_empty));
+		pthread_mutex_unlock(&(queue->mutex));
+	}
+
+	pthread_mutex_lock(&(queue->mutex));
+	queue->producers_nb--;
+	pthread_cond_broadcast(&(queue->not_empty));
+	pthread_mutex_unlock(&(queue->mutex));
+	return NULL;
+}
+
+void *consumer(void *arg) {
+	struct worker *worker = arg;
+	struct queue *queue = worker->queue;
+
+	void *ptrs[BATCH_SIZE];
+	while (1) {
+		size_t ptrs_nb = 0;
+		pthread_mutex_lock(&(queue->mutex));
+		while (queue->head == queue->tail && queue->producers_nb > 0)
+			pthread_cond_wait(&(queue->not_empty), &(queue->mutex));
+		while (ptrs_nb < BATCH_SIZE && queue->tail != queue->head)
+			ptrs[ptrs_nb++] = queue->ptrs[queue->tail++ % QUEUE_SIZE];
+		pthread_cond_broadcast(&(queue->not_full));
+		pthread_mutex_unlock(&(queue->mutex));
+
+		if (ptrs_nb == 0)
+			return NULL;
+
+		double start_time = now_ns();
+		for (size_t j = 0; j < ptrs_nb; j++)
+			free(ptrs[j]);
+		samples_add(&(worker->samples), now_ns() - start_time, ptrs_nb);
+	}
+}
+
+void bench_producer_consumer(size_t threads_nb) {
+	size_t blocks_nb = 50000 * repeat;
+	struct queue queue;
+	memset(&queue, 0, sizeof(queue));
+	queue.producers_nb = threads_nb;
+	pthread_mutex_init(&(queue.mutex), NULL);
+	pthread_cond_init(&(queue.not_empty), NULL);
+	pthread_cond_init(&(queue.not_full), NULL);
+
+	struct worker workers[2 * threads_nb];
+	pthread_t threads[2 * threads_nb];
+	for (size_t i = 0; i < 2 * threads_nb; i++) {
+		workers[i].queue = &queue;
+		workers[i].blocks_nb = blocks_nb;
+		workers[i].seed = 45 + i;
+		samples_init(&(workers[i].samples), blocks_nb / BATCH_SIZE + blocks_nb * threads_nb);
+		pthread_create(&threads[i], NULL, (i < threads_nb) ? producer : consumer, &workers[i]);
+	}
+	for (size_t i = 0; i < 2 * threads_nb; i++)
+		pthread_join(threads[i], NULL);
+
+	// Les échantillons des producteurs (allocations) et des consommateurs (libérations) sont regroupés
+	struct samples samples;
+	samples_init(&samples, 0);
+	for (size_t i = 0; i < 2 * threads_nb; i++) {
+		samples.values = realloc(samples.values, (samples.values_nb + workers[i].samples.values_nb) * sizeof(double));
+		memcpy(samples.values + samples.values_nb, workers[i].samples.values, workers[i].samples.values_nb * sizeof(double));
+		samples.values_nb += workers[i].samples.values_nb;
+		samples.ops_nb += workers[i].samples.ops_nb;
+		samples.total_time += workers[i].samples.total_time;
+		free(workers[i].samples.values);
+	}
+
+	report("producer_consumer", &samples, "threads", 2 * threads_nb);
+}
+
+int main(int argc, char **argv) {
+	const char *allocator_name = (argc > 1) ? argv[1] : "glibc";
+	if (argc > 2 && strtoul(argv[2], NULL, 10) > 0)
+		repeat = strtoul(argv[2], NULL, 10);
+
+	// Les mesures de "secmalloc" n'ont de sens que si malloc() est bien celle de libmy_secmalloc.so (make dynamic)
+	Dl_info malloc_info;
+	if (strcmp(allocator_name, "secmalloc") == 0 && (dladdr((void *) malloc, &malloc_info) == 0
+			|| malloc_info.dli_fname == NULL || strstr(malloc_info.dli_fname, "my_secmalloc") == NULL)) {
+		fprintf(stderr, "bench : malloc() ne provient pas de libmy_secmalloc.so (LD_PRELOAD, make dynamic) \n");
+		return EXIT_FAILURE;
+	}
+
+	printf("{\"allocator\": \"%s\", \"batch_size\": %d, \"results\": [", allocator_name, BATCH_SIZE);
+
+	bench_malloc_free("malloc_free_small", 8, 256);
+	bench_malloc_free("malloc_free_medium", 257, 4096);
+	bench_malloc_free("malloc_free_mixed", 0, 0);
+	bench_calloc_free();
+	bench_realloc_chain();
+	bench_heap_scaling(1000);
+	bench_heap_scaling(10000);
+	bench_heap_scaling(100000);
+	bench_producer_consumer(1);
+	bench_producer_consumer(4);
+
+	printf("\n]}\n");
+	return 0;
+}
@@ -2,19 +2,40 @@
 #define _AUXILIARY_FUNCTIONS_PRIVATE_H_
 #include <stddef.h> // size_t
 #include <pthread.h> // pthread_mutex_t
+#include <stdarg.h> // va_list
+#include <stdint.h> // uint64_t
 #include "auxiliary_functions.private.h"
 
+// STATISTIQUES
+void init_stats();
+void stats_signal_handler(int signal_number);
+struct thread_stats *get_thread_stats();
+void thread_stats_release(void *stats);
+void stats_count(int counter, size_t size);
+void stats_dump(int file_descriptor);
+size_t get_huge_page_bytes();
+int is_in_data_pool(size_t address);
+
 // GESTION DES RESSOURCES GLOBALES
 void init_page_size();
+void init_thread_cache();
+void init_mmap_threshold();
+void init_huge_pages();
+void init_slabs();
+void init_guard_pool();
+void init_deferred_wipe();
 void init_logs_file_descriptor();
+void init_log_level();
 
 long get_canary();
+unsigned char get_guard_slack_byte(size_t address);
 size_t 	get_page_size();
 size_t get_data_pool_size();
 int get_logs_file_descriptor();
 struct struct_canary *get_data_pool();
 size_t get_meta_information_pool_size();
 struct meta_information *get_meta_information_pool_root();
+struct arena *get_thread_arena();
 
 // GESTION DES ERREURS
 void handle_error(const char *error_message);
@@ -26,43 +47,100 @@ void mutex_unlock(pthread_mutex_t *mutex_ptr);
 int mutex_trylock(pthread_mutex_t *mutex_ptr);
 void mutex_destroy(pthread_mutex_t *mutex_ptr);
 void mutex_init(pthread_mutex_t *mutex_ptr, int recursive);
+struct spinlock; // Défini dans my_secmalloc.private.h
+void spinlock_init(struct spinlock *lock);
+void spinlock_lock(struct spinlock *lock);
+int spinlock_trylock(struct spinlock *lock);
+void spinlock_unlock(struct spinlock *lock);
 
 // DÉTECTION D'OVERFLOW
 void *dynamic_overflow_detection(void *arg);
+void init_overflow_scan();
+void add_recent_block(struct meta_information *meta_information_element);
+int scan_block(struct meta_information *meta_information_element);
+size_t scan_slab(size_t slab_index);
+
+// VÉRIFICATION DE L'INTÉGRITÉ DU TAS
+void *heap_check(void *arg);
+size_t check_meta_information_struct(struct meta_information *meta_information_element);
 
 // FONCTIONS AUXILIAIRES GÉNÉRALES
 size_t get_delta_size(size_t additional_memory_size);
+size_t get_data_pool_commit_size(size_t needed_size);
 void add_log(const char *string_format, int file_descriptor, ...);
 
+// JOURNAL ASYNCHRONE
+void init_log_flusher();
+struct log_ring *get_thread_log_ring();
+void log_ring_release(void *log_ring);
+void log_message(int level, const char *string_format, ...);
+size_t log_record_encode(char *record, const char *string_format, va_list ap);
+void log_ring_write(struct log_ring *log_ring, size_t position, const void *data, size_t size);
+void log_ring_read(struct log_ring *log_ring, size_t position, void *data, size_t size);
+void log_ring_push(struct log_ring *log_ring, const void *record, size_t record_size);
+void trace_operation(int operation, void *ptr, size_t count, size_t size, void *result, uint64_t timestamp);
+uint64_t get_timestamp();
+void log_flush();
+void log_flush_buffer(size_t *buffer_size);
+size_t log_format_record(char *buffer, uint64_t format);
+void *flush_logs(void *arg);
+
 // CRÉATION ET ÉLARGISSEMENT DE MAPPAGE DE MÉMOIRE
 void exit_handler();
-void	*init_memeory(void *memeory_to_init, void *address);
-void	*remap_memeory(void *memeory_to_realloc, size_t memeory_old_size, size_t delta_size);
+void	*map_memeory(void *address, size_t size);
+void	*reserve_memeory(size_t size);
+void	*reserve_memeory_aligned(size_t size, size_t alignment);
+size_t	commit_memeory(void *memeory, size_t committed_size, size_t needed_size, size_t reserved_size);
+size_t	decommit_memeory(void *memeory, size_t committed_size, size_t new_committed_size);
 
 // INITIALISATION
 void init();
 void pthread_init_once();
-struct struct_canary *init_data_pool();
-struct meta_information *init_meta_information_pool();
+void init_arenas();
+void init_arena(struct arena *arena);
+struct struct_canary *init_data_pool(struct arena *arena);
+struct meta_information *init_meta_information_pool(struct arena *arena);
 
 // EXTENSION DES ZONES MÉMOIRE
-void extend_meta_information_pool();
-void extend_data_pool(struct meta_information* last_meta_information_item, size_t data_pool_delta_size, size_t last_meta_information_item_new_size);
+void extend_meta_information_pool(struct arena *arena);
+void extend_data_pool(struct meta_information* last_meta_information_item, size_t data_pool_delta_size);
 
 // FONCTIONS POUVANT ÊTRE PASSÉES EN PARAMÈTRE À METADATA_LINKED_LIST_MAP OU METADATA_ARRAY_MAP
 int clean_data(struct meta_information *meta_information_element, void *arg2);
+int add_block_stats(struct meta_information *meta_information_element, void *stats);
 int overflow_detection(struct meta_information *meta_information_element, void *arg2);
 int is_last_meta_information_struct(struct meta_information *meta_information_element, void *arg2);
-int init_empty_meta_information_struct(struct meta_information * meta_information_element, void *arg2);
+int init_empty_meta_information_struct(struct meta_information * meta_information_element, void *arena);
 int init_if_empty_meta_information_struct(struct meta_information * meta_information_element, void *arg2);
 int is_meta_information_of_memory_ptr(struct meta_information * meta_information_element, void *memory_ptr);
 int is_meta_information_of_free_memory(struct meta_information * meta_information_element, void *memory_size);
 
+// GESTION DES BLOCS DE MÉTADONNÉES INUTILISÉS
+struct meta_information *get_unused_meta_information_struct(struct arena *arena);
+void put_unused_meta_information_struct(struct meta_information *meta_information_element);
+void unused_bitmap_extend(struct arena *arena, size_t first_index, size_t last_index);
+
+// GESTION DES LISTES DE BLOCS LIBRES
+void init_free_lists(struct arena *arena);
+size_t get_free_list_index(size_t size);
+struct meta_information *free_list_take(struct arena *arena, size_t size);
+void free_list_insert(struct meta_information *meta_information_element);
+void free_list_remove(struct meta_information *meta_information_element);
+void free_list_unlink(size_t index, struct meta_information *meta_information_element);
+
+// INDEX DES POINTEURS
+void init_pointer_index();
+void pointer_index_grow();
+size_t get_pointer_index_hash(void *memory_ptr);
+struct meta_information *pointer_index_find(void *memory_ptr);
+struct meta_information *pointer_index_remove(void *memory_ptr);
+void pointer_index_insert(struct meta_information *meta_information_element);
+
 // GESTION DE LA LISTE CHAÎNÉE DES MÉTADONNÉES
 struct meta_information *get_empty_meta_information_struct(struct meta_information *prev_meta_information_struct);
 struct meta_information *metadata_linked_list_map(struct meta_information * meta_information_root, int return_if_func_true,
 		int (*func) (struct meta_information *, void *), void *func_arg2, int unlock_mutex_before_return);
-struct meta_information *metadata_array_map(struct meta_information * meta_information_root, int return_if_func_true,
+struct meta_information *metadata_array_map(struct arena *arena, int return_if_func_true,
 		int (*func) (struct meta_information *, void *), void *func_arg2, size_t start_index, int unlock_mutex_before_return);
 
 #endif
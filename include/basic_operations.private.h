@@ -1,13 +1,59 @@
 #ifndef _BASIC_OPERATIONS_PRIVATE_H_
 #define _BASIC_OPERATIONS_PRIVATE_H_
 #include <stddef.h> // size_t
+#include <stdint.h> // uint16_t
 #include "auxiliary_functions.private.h"
 
 int	clean(void* ptr);
 void	*alloc(size_t);
-struct meta_information	*get_last_chunck_raw();
+void	*alloc_and_get_zeroed(size_t size, int *zeroed);
+void	*alloc_aligned(size_t alignment, size_t size);
+void	release_chunck(struct meta_information *meta_information_struct);
+struct meta_information *lock_prev_chunck(struct meta_information *meta_information_struct);
+void	absorb_next_chunck(struct meta_information *meta_information_struct, struct meta_information *next_meta_information_struct);
+struct meta_information	*get_last_chunck_raw(struct arena *arena);
 struct meta_information	*get_free_chunck(size_t size);
 int merge_if_free(struct meta_information * meta_information_element, void *arg2);
 int  memory_division(struct meta_information *meta_information_struct, size_t size);
 
+// RESTITUTION DE LA MÉMOIRE AU SYSTÈME
+size_t	trim_data_pool(struct arena *arena);
+int	release_free_pages(struct meta_information *meta_information_element, void *released_size);
+
+// GRANDES ALLOCATIONS
+void	*alloc_mapped(size_t size);
+void	*alloc_mapped_aligned(size_t alignment, size_t size);
+void	*resize_mapped_chunck(struct meta_information *meta_information_struct, size_t size);
+void	release_mapped_chunck(struct meta_information *meta_information_struct);
+
+// ALLOCATIONS ÉCHANTILLONNÉES (PAGES DE GARDE)
+int	guard_sample();
+void	*alloc_guarded(size_t size);
+void	release_guarded_chunck(struct meta_information *meta_information_struct);
+
+// SLABS (PETITES ALLOCATIONS)
+int	is_in_slab_pool(void *ptr);
+uint16_t	get_slab_canary(void *slot);
+int	slab_slot_overflow_detection(void *slot, size_t slot_size);
+size_t	slab_overflow_detection(struct slab *slab);
+struct slab_class	*lock_slab_class(struct slab *slab, int trylock);
+void	slab_list_insert(struct slab **head, struct slab *slab);
+void	slab_list_remove(struct slab **head, struct slab *slab);
+struct slab	*new_slab(struct arena *arena, size_t class_index);
+void	*alloc_slab_slot(size_t size);
+int	release_slab_slot(void *ptr);
+size_t	get_slab_slot_size(void *ptr);
+size_t	release_empty_slabs();
+
+// NETTOYAGE DIFFÉRÉ
+int	wipe_queue_push(struct meta_information *meta_information_struct);
+void	*deferred_wipe(void *arg);
+
+// CACHE PAR THREAD
+void	*thread_cache_pop(size_t size);
+void	thread_cache_flush(void *arg);
+int	thread_cache_push(struct meta_information *meta_information_struct);
+void	thread_cache_note_owned(struct meta_information *meta_information_struct);
+struct meta_information	*thread_cache_find_owned(void *ptr);
+
 #endif
@@ -7,5 +7,41 @@ void    free(void *ptr);
 void    *malloc(size_t size);
 void    *calloc(size_t nmemb, size_t size);
 void    *realloc(void *ptr, size_t size);
+int     posix_memalign(void **memptr, size_t alignment, size_t size);
+void    *aligned_alloc(size_t alignment, size_t size);
+void    *memalign(size_t alignment, size_t size);
+void    *valloc(size_t size);
+void    *pvalloc(size_t size);
+void    *reallocarray(void *ptr, size_t nmemb, size_t size);
+size_t  malloc_usable_size(void *ptr);
+
+// Statistiques de l'allocateur (secmalloc_stats()). La classe de taille i correspond aux allocations
+// de 2^i à 2^(i+1) - 1 octets.
+#define SECMALLOC_SIZE_CLASSES_NB 64
+
+struct secmalloc_stats {
+	size_t mapped_bytes; // Mémoire accessible obtenue du système (pools, grandes allocations, allocations échantillonnées)
+	size_t live_bytes; // Octets des blocs occupés
+	size_t free_bytes; // Octets des blocs libres (y compris ceux des caches des threads et en attente de nettoyage)
+	size_t metadata_bytes; // Pools de meta-information, bitmaps des blocs inutilisés et index des pointeurs
+	size_t largest_free_block; // Taille du plus grand bloc libre
+	size_t huge_page_bytes; // Octets des pools de data soutenus par des pages de grande taille (AnonHugePages de /proc/self/smaps)
+	size_t slab_bytes; // Octets des slabs (petites allocations), inclus dans mapped_bytes
+	size_t slab_slots_nb; // Emplacements occupés des slabs (non comptés dans busy_blocks_nb)
+	size_t busy_blocks_nb; // Blocs occupés dans les pools de data
+	size_t free_blocks_nb;
+	size_t mapped_blocks_nb; // Grandes allocations
+	size_t guarded_blocks_nb; // Allocations échantillonnées
+	size_t allocations_nb; // Nombre total d'allocations (my_malloc(), my_calloc() et déplacements par my_realloc())
+	size_t frees_nb; // Nombre total de libérations
+	size_t calloc_calls_nb;
+	size_t realloc_calls_nb;
+	size_t size_classes[SECMALLOC_SIZE_CLASSES_NB]; // Nombre total d'allocations par classe de taille
+};
+
+void    secmalloc_coalesce();
+size_t  secmalloc_check();
+size_t  secmalloc_trim();
+void    secmalloc_stats(struct secmalloc_stats *stats);
 
 #endif
@@ -4,6 +4,7 @@
 #include "my_secmalloc.h"
 
 #include <stddef.h> // size_t
+#include <stdint.h> // uint32_t, uint64_t
 #include <pthread.h> // pthread_mutex_t
 #include <unistd.h> // STDOUT_FILENO
 
@@ -11,44 +12,413 @@
 // l'opérateur '##' a une signification particulière lorsqu'il est placé entre une virgule et un argument variable :
 // si l'argument variable n'est pas utilisé lorsque la macro est utilisée, alors la virgule avant le '##' sera supprimée
 // Source : https://gcc.gnu.org/onlinedocs/cpp/Variadic-Macros.html
-#define LOG(format, ...) add_log(format, get_logs_file_descriptor(), ##__VA_ARGS__) // ;add_log(format, STDOUT_FILENO, ##__VA_ARGS__)
-#define DEBUG(format, ...) // add_log(format, get_logs_file_descriptor(), ##__VA_ARGS__) // ;add_log(format, STDOUT_FILENO, ##__VA_ARGS__)
-#define LOG_ERROR(format, ...) add_log(format, get_logs_file_descriptor(), ##__VA_ARGS__); add_log(format, STDOUT_FILENO, ##__VA_ARGS__)
+
+// Niveaux des messages du journal : LOG_ERROR (erreurs), LOG (initialisation, élargissement des pools, maintenance du tas),
+// DEBUG (chaque allocation, libération et division de bloc) et TRACE (verrous, parcours des blocs de métadonnées).
+// Les niveaux supérieurs à LOG_LEVEL_MAX ne sont pas compilés (make LOG_LEVEL_MAX=2 pour ne conserver que LOG_ERROR et LOG).
+// À l'exécution, seuls les messages d'un niveau inférieur ou égal à log_level (variable d'environnement MSM_LOG_LEVEL)
+// sont écrits : lorsque le journal est désactivé, un message ne coûte qu'une comparaison.
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_DEBUG 3
+#define LOG_LEVEL_TRACE 4
+
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_AT_LEVEL(level, format, ...) do { \
+		if ((level) <= LOG_LEVEL_MAX && __builtin_expect((level) <= log_level, 0)) \
+			log_message(level, format, ##__VA_ARGS__); \
+	} while (0)
+
+#define LOG(format, ...) LOG_AT_LEVEL(LOG_LEVEL_INFO, format, ##__VA_ARGS__) // ;add_log(format, STDOUT_FILENO, ##__VA_ARGS__)
+#define DEBUG(format, ...) LOG_AT_LEVEL(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#define TRACE(format, ...) LOG_AT_LEVEL(LOG_LEVEL_TRACE, format, ##__VA_ARGS__)
+// Les messages d'erreur sont écrits immédiatement, car ils précèdent le plus souvent la fin du programme
+#define LOG_ERROR(format, ...) do { \
+		log_message(LOG_LEVEL_ERROR, format, ##__VA_ARGS__); \
+		log_flush(); \
+		add_log(format, STDOUT_FILENO, ##__VA_ARGS__); \
+	} while (0)
 
 typedef char byte;
 
-enum status {
+enum __attribute__((packed)) status { // 1 octet
 	FREE = 0,
 	BUSY = 1,
-	UNUSED = 2
+	UNUSED = 2,
+	CACHED = 3, // Bloc libéré (nettoyé) conservé dans le cache d'un thread
+	MAPPED = 4, // Grande allocation occupée qui dispose de son propre mappage (hors du pool de données)
+	GUARDED = 5, // Allocation occupée échantillonnée, placée contre une page de garde (hors du pool de données)
+	WIPING = 6 // Bloc libéré en attente de nettoyage par le thread de nettoyage différé
 };
 
 struct struct_canary {
 	long canary;
 };
 
+// Alignement des pointeurs renvoyés (celui de max_align_t). Le pool de data commence au début d'une page : la taille
+// d'un bloc du pool de data est arrondie de sorte que la taille du bloc et de son canari soit un multiple de
+// ALLOCATION_ALIGNMENT, et le bloc suivant commence donc lui aussi à une adresse alignée.
+#define ALLOCATION_ALIGNMENT 16
+#define ALIGN_SIZE(size) ((((size) + sizeof(struct struct_canary) + ALLOCATION_ALIGNMENT - 1) & ~((size_t) ALLOCATION_ALIGNMENT - 1)) \
+		- sizeof(struct struct_canary))
+// Taille maximale qui peut être arrondie par ALIGN_SIZE() sans dépasser la valeur maximale d'un size_t
+#define ALIGN_SIZE_MAX (SIZE_MAX - sizeof(struct struct_canary) - (ALLOCATION_ALIGNMENT - 1))
+
+// Verrou tournant (spinlock) d'un bloc de métadonnées : 4 octets au lieu des 40 octets d'un pthread_mutex_t.
+// Il n'est pas récursif : un thread ne doit jamais reprendre le verrou d'un bloc qu'il détient déjà.
+struct spinlock {
+	int locked;
+};
+
+// Nombre maximal d'itérations d'attente active entre deux tentatives de prise d'un spinlock, avant sched_yield()
+#define SPINLOCK_MAX_BACKOFF 64
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define cpu_relax() __asm__ __volatile__("yield")
+#else
+#define cpu_relax() __asm__ __volatile__("" ::: "memory")
+#endif
+
 struct meta_information {
+	struct arena *arena; // Arène dont le pool de meta-information contient ce bloc de métadonnées
 	struct struct_canary *data_ptr; // Pointeur vers le debut du bloc dans le pool de data
 	enum status status;  // Etat du bloc allouée (occupée ou libre)
+	// Le bloc de données d'un bloc qui n'est pas occupé ne contient que des zéros (mémoire nouvellement
+	// mappée ou nettoyée lors de la libération) : my_calloc() n'a pas besoin de le mettre à zéro
+	unsigned char zeroed;
+	struct spinlock lock;
 	size_t size;	// Taille du bloc
 
 	struct meta_information* prev;
 	struct meta_information* next;
+
+	// Un bloc libre appartient à une liste de blocs libres, un bloc occupé (ou conservé dans le cache
+	// d'un thread) appartient à l'index des pointeurs : les deux chaînages ne sont jamais utilisés en même temps
+	union {
+		// Chaînage des blocs libres d'une même classe de taille (uniquement si status == FREE)
+		struct meta_information* prev_free;
+		// Chaînage des blocs occupés d'une même case de l'index des pointeurs (uniquement si status == BUSY ou CACHED)
+		struct meta_information* next_in_index;
+	};
+
+	// Chaînage des blocs libres d'une même classe de taille (FREE) ou des blocs du cache d'un thread (CACHED)
+	struct meta_information* next_free;
+}; // 64 octets : un bloc de métadonnées par ligne de cache
+
+// Listes de blocs libres triés par classe de taille : la liste d'indice i contient
+// les blocs libres dont la taille est comprise entre 2^i et 2^(i+1) - 1 octets
+#define FREE_LISTS_NB (sizeof(size_t) * 8)
+
+struct free_list {
+	struct meta_information *head;
+	pthread_mutex_t mutex;
+};
+
+// Nombre de bits d'un mot d'une bitmap
+#define BITMAP_WORD_BITS (sizeof(size_t) * 8)
+
+// Espace d'adressage virtuel réservé (PROT_NONE) pour les pools de chaque arène. Seule la partie utilisée
+// est rendue accessible, par étapes de taille croissante : les pools ne sont jamais déplacés.
+#define DATA_POOL_RESERVED_SIZE ((size_t) 1 << 35) // 32 Gio
+
+// Pages de grande taille (variable d'environnement MSM_HUGE_PAGES) : le pool de data de chaque arène est réservé
+// à une adresse multiple de HUGE_PAGE_SIZE, marqué MADV_HUGEPAGE, et sa partie accessible est élargie (ou réduite)
+// par multiples de HUGE_PAGE_SIZE, afin que le noyau puisse le soutenir par des pages transparentes de grande taille
+#define HUGE_PAGE_SIZE ((size_t) 2 * 1024 * 1024) // 2 Mio
+#define META_INFORMATION_POOL_RESERVED_SIZE ((size_t) 1 << 34) // 16 Gio
+#define UNUSED_BITMAP_RESERVED_SIZE (META_INFORMATION_POOL_RESERVED_SIZE / sizeof(struct meta_information) / 8)
+
+// Seuil par défaut (modifiable avec la variable d'environnement MSM_MMAP_THRESHOLD) au-delà duquel
+// une allocation dispose de son propre mappage au lieu d'être découpée dans le pool de données
+#define MMAP_THRESHOLD_DEFAULT ((size_t) 128 * 1024) // 128 Kio
+#define MMAP_THRESHOLD_MAX ((size_t) 1 << 32) // 4 Gio (un bloc du pool de data doit rester bien plus petit que DATA_POOL_RESERVED_SIZE)
+
+// Nombre de blocs récemment alloués (ou redimensionnés) conservés par chaque arène, afin que le thread
+// de parcours du tas les vérifie en priorité à chaque passage
+#define RECENT_BLOCKS_NB 64
+
+// Valeurs par défaut du thread de parcours du tas (modifiables avec les variables d'environnement
+// MSM_SCAN_BATCH, MSM_SCAN_BUDGET_US et MSM_SCAN_INTERVAL_MS)
+#define SCAN_BATCH_SIZE_DEFAULT 4096 // Nombre maximal de blocs de métadonnées vérifiés par passage
+#define SCAN_TIME_BUDGET_DEFAULT 500 // Durée maximale d'un passage (en microsecondes)
+#define SCAN_INTERVAL_DEFAULT 100 // Intervalle entre deux passages (en millisecondes)
+
+// Slabs (variable d'environnement MSM_SLABS) : une allocation d'au plus SLAB_SLOT_MAX_SIZE octets est placée dans un
+// emplacement d'un slab, zone de SLAB_SIZE octets découpée en emplacements de même taille (un multiple de
+// ALLOCATION_ALIGNMENT, de ALLOCATION_ALIGNMENT à SLAB_MAX_SIZE octets selon la classe). Elle ne coûte ni bloc de
+// métadonnées ni struct_canary : les 2 derniers octets de chaque emplacement contiennent un canari compact, et les
+// métadonnées du slab (bitmap des emplacements occupés) sont conservées hors du slab, dans un tableau de descripteurs.
+// Les slabs sont découpés dans une zone réservée commune à toutes les arènes, mais chaque slab appartient à une arène.
+#define SLAB_SIZE ((size_t) 4096)
+#define SLAB_MAX_SIZE 256
+#define SLAB_CANARY_SIZE sizeof(uint16_t)
+#define SLAB_SLOT_MAX_SIZE (SLAB_MAX_SIZE - SLAB_CANARY_SIZE)
+#define SLAB_CLASSES_NB (SLAB_MAX_SIZE / ALLOCATION_ALIGNMENT) // La classe d'indice i contient des emplacements de (i + 1) * ALLOCATION_ALIGNMENT octets
+#define SLAB_SLOTS_MAX_NB (SLAB_SIZE / ALLOCATION_ALIGNMENT)
+#define SLAB_POOL_RESERVED_SIZE ((size_t) 1 << 34) // 16 Gio
+#define SLAB_DESCRIPTORS_RESERVED_SIZE (SLAB_POOL_RESERVED_SIZE / SLAB_SIZE * sizeof(struct slab))
+
+// Descripteur d'un slab. Il est modifié uniquement en présence du verrou de la classe de son arène
+// (ou du verrou du pool de slabs, si le slab est vide et n'appartient à aucune arène).
+struct slab {
+	struct arena *arena; // Arène du slab (NULL si le slab est vide et n'appartient à aucune arène)
+	// Chaînage des slabs non pleins d'une même classe d'une arène, ou des slabs vides du pool (next uniquement)
+	struct slab *prev;
+	struct slab *next;
+	uint16_t slot_size; // Taille d'un emplacement, canari compris
+	uint16_t slots_nb;
+	uint16_t used_slots_nb;
+	uint8_t class_index;
+	uint8_t released; // Les pages du slab vide ont été rendues au système par secmalloc_trim()
+	size_t used_slots[SLAB_SLOTS_MAX_NB / BITMAP_WORD_BITS]; // Le bit i est à 1 si l'emplacement i est occupé
+}; // 64 octets de métadonnées pour SLAB_SIZE octets de données
+
+struct slab_class {
+	struct slab *partial_slabs; // Slabs de l'arène dont au moins un emplacement est libre
+	pthread_mutex_t mutex;
+};
+
+struct slab_pool {
+	char *slabs; // Zone réservée de SLAB_POOL_RESERVED_SIZE octets : le slab d'indice i commence à slabs + i * SLAB_SIZE
+	struct slab *descriptors; // Zone réservée : descriptors[i] est le descripteur du slab d'indice i
+	size_t slabs_nb; // Nombre de slabs créés (modifié de manière atomique, les slabs ne sont jamais supprimés)
+	size_t slabs_committed_size;
+	size_t descriptors_committed_size;
+	struct slab *empty_slabs; // Slabs vides rendus par leur arène, chaînés à l'aide de next
+	pthread_mutex_t mutex; // Protège la création des slabs et empty_slabs
+};
+
+// Arène : un pool de data, un pool de meta-information (et sa liste chaînée) et des listes de blocs libres
+// qui lui sont propres. Chaque thread est associé à une arène à tour de rôle, afin que des threads
+// différents n'accèdent pas aux mêmes verrous. Le nombre d'arènes est celui des processeurs disponibles,
+// ou la valeur de la variable d'environnement MSM_ARENAS (au plus ARENAS_MAX_NB).
+#define ARENAS_MAX_NB 64
+
+struct arena {
+	size_t index;
+	int initialized;
+	pthread_mutex_t mutex; // Protège l'initialisation de l'arène
+
+	struct struct_canary *data_pool;
+	size_t data_pool_size;
+	size_t data_pool_committed_size; // Nombre d'octets du pool de data accessibles en lecture et en écriture
+
+	struct meta_information *meta_information_pool_root;
+	struct meta_information *meta_information_pool_last;
+	size_t meta_information_pool_size;
+	size_t meta_information_pool_committed_size;
+	pthread_mutex_t meta_information_pool_mutex; // Protège l'élargissement du pool de meta-information et unused_bitmap
+
+	size_t *unused_bitmap; // Le bit i est à 1 si le bloc de métadonnées d'indice i est inutilisé
+	size_t unused_bitmap_size; // Nombre d'octets de unused_bitmap accessibles en lecture et en écriture
+	size_t unused_bitmap_hint; // Aucun mot de unused_bitmap d'indice inférieur ne contient de bit à 1
+
+	struct free_list free_lists[FREE_LISTS_NB];
+	size_t free_lists_bitmap; // Le bit i est à 1 si la liste de blocs libres d'indice i n'est pas vide
+
+	struct meta_information *recent_blocks[RECENT_BLOCKS_NB]; // Tampon circulaire des blocs récemment alloués
+	size_t recent_blocks_next; // Nombre total de blocs ajoutés au tampon (modifié de manière atomique)
+
+	struct slab_class slab_classes[SLAB_CLASSES_NB];
+} __attribute__((aligned(64))); // Deux arènes ne partagent pas de ligne de cache
+
+// Index des pointeurs : table de hachage qui associe l'adresse de début d'un bloc occupé
+// à son bloc de métadonnées. Chaque verrou protège les cases d'indice i tels que
+// i % POINTER_INDEX_MUTEXES_NB est identique, quel que soit le nombre de cases.
+#define POINTER_INDEX_MUTEXES_NB 64
+#define POINTER_INDEX_MAX_LOAD 2 // Nombre moyen de blocs par case au-delà duquel la table est agrandie
+
+struct pointer_index {
+	struct meta_information **buckets;
+	size_t buckets_nb; // Puissance de 2, supérieure ou égale à POINTER_INDEX_MUTEXES_NB
+	size_t elements_nb;
+	pthread_mutex_t mutexes[POINTER_INDEX_MUTEXES_NB];
+};
+
+// Cache par thread : blocs récemment libérés par le thread, triés par taille. La case d'indice i
+// contient des blocs dont la taille est comprise entre i * THREAD_CACHE_GRANULARITY + 1 et
+// (i + 1) * THREAD_CACHE_GRANULARITY octets. Les blocs sont chaînés à l'aide de next_free.
+#define THREAD_CACHE_BUCKETS_NB 16
+#define THREAD_CACHE_GRANULARITY 16
+// Les blocs obtenus par le thread sont aussi notés dans une table à correspondance directe (indexée par l'adresse
+// des données) : leur libération par ce même thread les retrouve sans consulter l'index des pointeurs, qui est global
+#define THREAD_CACHE_OWNED_NB 64
+
+struct thread_cache {
+	struct meta_information *buckets[THREAD_CACHE_BUCKETS_NB];
+	size_t blocks_nb[THREAD_CACHE_BUCKETS_NB];
+	struct meta_information *owned[THREAD_CACHE_OWNED_NB];
+	int registered; // Le destructeur de thread_cache_key a été activé pour ce thread
+};
+
+// Pool des allocations échantillonnées : GUARD_POOL_SLOTS_NB emplacements, chacun formé d'une page de données
+// suivie d'une page de garde (PROT_NONE). Les données sont placées à la fin de la page de données, contre la
+// page de garde : un overflow provoque une erreur de segmentation à l'instruction fautive.
+#define GUARD_POOL_SLOTS_NB 256
+
+struct guard_pool {
+	char *slots; // Zone réservée de GUARD_POOL_SLOTS_NB * 2 pages
+	size_t used_slots[GUARD_POOL_SLOTS_NB / BITMAP_WORD_BITS]; // Le bit i est à 1 si l'emplacement i est utilisé
+	size_t next_slot; // Emplacement à partir duquel la recherche commence (un emplacement libéré n'est pas réutilisé aussitôt)
+	pthread_mutex_t mutex;
+};
+
+// Nettoyage différé : les blocs libérés d'au moins deferred_wipe_min_size octets sont nettoyés par un thread
+// dédié, puis rendus au tas. Au-delà de WIPE_QUEUE_MAX_SIZE octets en attente, le nettoyage se fait
+// de nouveau lors de la libération, afin de borner la mémoire qui n'est pas encore réutilisable.
+#define WIPE_QUEUE_MAX_SIZE ((size_t) 64 * 1024 * 1024) // 64 Mio
+
+struct wipe_queue {
+	struct meta_information *head; // Blocs en attente de nettoyage (statut WIPING), chaînés à l'aide de next_free
+	size_t size; // Nombre d'octets en attente de nettoyage
 	pthread_mutex_t mutex;
+	pthread_cond_t cond; // Signalée lorsqu'un bloc est ajouté à la file
+};
+
+// Vérification de l'intégrité du tas (secmalloc_check()) : le pool de meta-information de chaque arène
+// est partagé entre au plus HEAP_CHECK_WORKERS_MAX threads, le thread d'indice i vérifiant la i-ème tranche
+#define HEAP_CHECK_WORKERS_MAX 8
+
+struct heap_check_worker {
+	size_t index;
+	size_t workers_nb;
+	size_t errors_nb; // Nombre d'incohérences détectées par ce thread
+};
+
+// Journal asynchrone : lorsque le fichier des logs a pu être ouvert, chaque thread ajoute ses messages, dans un format
+// binaire compact, à son propre tampon circulaire (un seul producteur, le thread, et un seul consommateur, le thread
+// d'écriture du journal), sans verrou ni appel système. Le thread d'écriture du journal vide les tampons toutes les
+// LOG_FLUSH_INTERVAL_MS millisecondes, en regroupant les enregistrements dans un même write().
+// Lorsqu'un tampon est plein, le thread qui écrit le message vide lui-même les tampons.
+// L'outil tools/msm_logdump reconstitue le texte des messages.
+#define LOG_RING_SIZE ((size_t) 1024 * 1024) // Puissance de 2
+#define LOG_FLUSH_BUFFER_SIZE ((size_t) 256 * 1024)
+#define LOG_FLUSH_INTERVAL_MS 10
+#define LOG_STRING_MAX_SIZE 256 // Taille maximale d'un argument %s copié dans un enregistrement
+#define LOG_RECORD_MAX_SIZE 4096
+#define LOG_KNOWN_FORMATS_NB 1024
+
+enum log_record_type {
+	LOG_RECORD_MESSAGE = 1, // En-tête suivi d'un mot de 8 octets par argument (une chaîne %s est précédée de sa longueur)
+	LOG_RECORD_FORMAT = 2, // En-tête suivi du texte de la chaîne de format (terminé par '\0'), écrit avant sa première utilisation
+	LOG_RECORD_DROPPED = 3, // En-tête suivi du nombre de messages perdus (tampon plein malgré son vidage) par un thread depuis le dernier enregistrement de ce type
+	LOG_RECORD_TRACE = 4 // Appel à malloc(), free(), calloc() ou realloc() (struct trace_record)
+};
+
+// En-tête d'un enregistrement du journal. La taille de chaque enregistrement est un multiple de 8 octets.
+struct log_record {
+	uint32_t size; // Taille de l'enregistrement, en-tête compris
+	uint32_t type;
+	uint64_t format; // Adresse de la chaîne de format, qui l'identifie
+	uint64_t timestamp; // CLOCK_MONOTONIC, en nanosecondes
+};
+
+// Enregistrement des allocations (MSM_TRACE) : chaque appel à malloc(), free(), calloc() et realloc() de la bibliothèque
+// dynamique est ajouté au journal. L'outil tools/msm_replay rejoue ces appels.
+enum trace_operation_type {
+	TRACE_MALLOC = 1,
+	TRACE_FREE = 2,
+	TRACE_CALLOC = 3,
+	TRACE_REALLOC = 4,
+	TRACE_MEMALIGN = 5 // posix_memalign(), aligned_alloc(), memalign(), valloc() et pvalloc() (count : alignement)
+};
+
+struct trace_record {
+	struct log_record header;
+	uint32_t operation;
+	uint32_t thread; // Numéro du thread (à partir de 1, dans l'ordre de leur premier appel enregistré)
+	uint64_t ptr; // Argument ptr de free() et realloc()
+	uint64_t count; // Argument nmemb de calloc(), ou alignement
+	uint64_t size; // Argument size de malloc(), calloc() et realloc()
+	uint64_t result; // Pointeur renvoyé
+};
+
+struct log_ring {
+	size_t head; // Position d'écriture, modifiée uniquement par le thread propriétaire
+	size_t tail; // Position de lecture, modifiée uniquement par le thread d'écriture du journal
+	size_t dropped_nb; // Messages perdus, modifié uniquement par le thread propriétaire
+	size_t reported_dropped_nb; // Messages perdus déjà signalés, modifié uniquement par le thread d'écriture du journal
+	int released; // Le thread propriétaire s'est terminé : le tampon peut être repris par un autre thread
+	struct log_ring *next;
+	char buffer[LOG_RING_SIZE];
+};
+
+struct log_flusher {
+	struct log_ring *rings; // Tampons de tous les threads (ajout en tête sans verrou, jamais retirés)
+	pthread_key_t ring_key; // Le destructeur rend le tampon d'un thread qui se termine disponible
+	char *buffer; // Enregistrements regroupés avant write()
+	uint64_t known_formats[LOG_KNOWN_FORMATS_NB]; // Chaînes de format déjà écrites dans le fichier des logs
+	pthread_mutex_t mutex; // Un seul thread vide les tampons à la fois
+};
+
+// Compteurs de chaque thread, modifiés uniquement par ce thread (sans instruction atomique) et additionnés par
+// secmalloc_stats(). Les compteurs d'un thread terminé sont repris par un nouveau thread, sans être remis à zéro.
+enum stats_counter {
+	STATS_ALLOCATIONS,
+	STATS_FREES,
+	STATS_CALLOC_CALLS,
+	STATS_REALLOC_CALLS,
+	STATS_COUNTERS_NB
+};
+
+struct thread_stats {
+	size_t counters[STATS_COUNTERS_NB];
+	size_t size_classes[SECMALLOC_SIZE_CLASSES_NB];
+	int released; // Le thread propriétaire s'est terminé
+	struct thread_stats *next;
 };
 
 // RESSOURCES GLOBALES
 extern size_t page_size;
 extern int logs_file_descriptor;
+extern int log_level;
+extern struct log_flusher log_flusher;
+extern __thread struct log_ring *thread_log_ring;
+extern int trace_enabled;
+extern uint32_t trace_threads_nb;
+extern __thread uint32_t trace_thread_id;
+
+extern struct arena arenas[ARENAS_MAX_NB];
+extern size_t arenas_nb;
+extern size_t next_arena_index;
+extern __thread struct arena *thread_arena;
+
+extern struct pointer_index pointer_index;
+
+extern size_t thread_cache_capacity;
+extern pthread_key_t thread_cache_key;
+extern __thread struct thread_cache thread_cache;
+
+extern struct thread_stats *thread_stats_list;
+extern pthread_key_t thread_stats_key;
+extern __thread struct thread_stats *thread_stats;
+extern int stats_signal;
+extern int stats_dump_requested;
 
-extern struct struct_canary *data_pool;
-extern struct meta_information *meta_information_pool_root;
+extern size_t mmap_threshold;
+extern int huge_pages_enabled;
 
-extern size_t data_pool_size;
-extern size_t meta_information_pool_size;
+extern int slabs_enabled;
+extern struct slab_pool slab_pool;
+
+extern size_t guard_sample_rate;
+extern __thread size_t guard_sample_counter;
+extern struct guard_pool guard_pool;
 
 extern pthread_once_t already_initialized;
+extern size_t deferred_wipe_min_size;
+extern struct wipe_queue wipe_queue;
+
 extern int dynamic_overflow_detection_activated;
+extern size_t scan_batch_size;
+extern size_t scan_time_budget;
+extern size_t scan_interval;
 extern pthread_mutex_t dynamic_overflow_detection_activated_mutex;
 
 // FONCTIONS PRINCIPALES
@@ -57,4 +427,19 @@ void    *my_malloc(size_t size);
 void    *my_realloc(void *ptr, size_t size);
 void    *my_calloc(size_t nmemb, size_t size);
 
+// ALLOCATIONS ALIGNÉES
+int     my_posix_memalign(void **memptr, size_t alignment, size_t size);
+void    *my_aligned_alloc(size_t alignment, size_t size);
+void    *my_memalign(size_t alignment, size_t size);
+void    *my_valloc(size_t size);
+void    *my_pvalloc(size_t size);
+void    *my_reallocarray(void *ptr, size_t nmemb, size_t size);
+size_t  my_malloc_usable_size(void *ptr);
+
+// MAINTENANCE DU TAS
+void    secmalloc_coalesce();
+size_t  secmalloc_check();
+size_t  secmalloc_trim();
+void    secmalloc_stats(struct secmalloc_stats *stats);
+
 #endif
@@ -2,12 +2,12 @@
  * Le code contient des commentaires dont la source est le projet de pages de manuel Linux ou du manuel du programmeur POSIX
  * (The Linux man-pages project / POSIX Programmer's Manual)
  */
-#define _GNU_SOURCE // Pour mremap()
+#define _GNU_SOURCE // Pour MAP_ANONYMOUS, MADV_HUGEPAGE
 #include <stdio.h> // fprintf()
-#include <stdlib.h> // exit(), atexit(), getenv(), EXIT_FAILURE
+#include <stdlib.h> // exit(), atexit(), getenv(), strtoul(), EXIT_FAILURE
 #include <alloca.h> // alloca()
-#include <unistd.h> // write(), sysconf(), fcntl()
-#include <sys/mman.h> // mmap(), mremap(), munmap()
+#include <unistd.h> // write(), sysconf(), fcntl(), usleep()
+#include <sys/mman.h> // mmap(), munmap(), mprotect(), madvise()
 #include <string.h> // memcpy(), memset(), strerror()
 #include <stdarg.h> // vsnprintf()
 #include <pthread.h> // pthread_once(), pthread_create(), pthread_mutex_ ... , pthread_mutexattr_ ...
@@ -16,6 +16,9 @@
 #include <sys/types.h> // fcntl()
 #include <sys/stat.h> // fcntl()
 #include <fcntl.h> // open(), fcntl()
+#include <sched.h> // sched_yield()
+#include <time.h> // clock_gettime()
+#include <signal.h> // sigaction()
 #include "auxiliary_functions.private.h"
 #include "my_secmalloc.private.h"
 #include "basic_operations.private.h"
@@ -24,19 +27,469 @@
 /* ******************** DÉTECTION D'OVERFLOW ************************ */
 /* ****************************************************************** */
 
+// Le thread de parcours du tas effectue des passages de durée bornée, séparés de scan_interval millisecondes.
+// À chaque passage, il vérifie d'abord les blocs récemment alloués de chaque arène (là où un overflow
+// est le plus probable), puis au plus scan_batch_size blocs de métadonnées à partir de l'endroit où
+// le passage précédent s'est arrêté, sans dépasser scan_time_budget microsecondes.
+// Les verrous des blocs sont seulement essayés (spinlock_trylock) : un bloc occupé par un autre thread
+// est vérifié lors d'un prochain passage, et une allocation n'attend jamais le thread de parcours.
+
+void init_overflow_scan() {
+	const char *scan_batch_size_str = getenv("MSM_SCAN_BATCH");
+	if (scan_batch_size_str != NULL)
+		scan_batch_size = strtoul(scan_batch_size_str, NULL, 10);
+
+	const char *scan_time_budget_str = getenv("MSM_SCAN_BUDGET_US");
+	if (scan_time_budget_str != NULL)
+		scan_time_budget = strtoul(scan_time_budget_str, NULL, 10);
+
+	const char *scan_interval_str = getenv("MSM_SCAN_INTERVAL_MS");
+	if (scan_interval_str != NULL)
+		scan_interval = strtoul(scan_interval_str, NULL, 10);
+}
+
+/**
+ * La fonction add_recent_block() ajoute un bloc qui vient d'être alloué (ou redimensionné) au tampon
+ * circulaire des blocs récemment alloués de son arène.
+ */
+void add_recent_block(struct meta_information *meta_information_element) {
+	struct arena *arena = meta_information_element->arena;
+	size_t index = __atomic_fetch_add(&(arena->recent_blocks_next), 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&(arena->recent_blocks[index % RECENT_BLOCKS_NB]), meta_information_element, __ATOMIC_RELAXED);
+}
+
+/**
+ * La fonction scan_block() vérifie le canari d'un bloc si son verrou est disponible.
+ * Elle renvoie 1 si le verrou a pu être pris, 0 sinon. Le processus se termine si un overflow est détecté.
+ */
+int scan_block(struct meta_information *meta_information_element) {
+	if (!spinlock_trylock(&(meta_information_element->lock)))
+		return 0;
+
+	if (overflow_detection(meta_information_element, NULL)) {
+		LOG_ERROR("Detection d'overflow : bloc mémoire commençant à l'adresse %p, (l'adresse du bloc de metadonnees concerne est %p) \n",
+				meta_information_element->data_ptr, meta_information_element);
+		spinlock_unlock(&(meta_information_element->lock));
+		exit (EXIT_FAILURE);
+	}
+
+	spinlock_unlock(&(meta_information_element->lock));
+	return 1;
+}
+
+/**
+ * La fonction scan_slab() vérifie les canaris des emplacements occupés du slab d'indice slab_index si le verrou
+ * de sa classe est disponible. Elle renvoie le nombre d'emplacements du slab vérifiés. Le processus se termine
+ * si un overflow est détecté.
+ */
+size_t scan_slab(size_t slab_index) {
+	struct slab *slab = &(slab_pool.descriptors[slab_index]);
+	struct slab_class *slab_class = lock_slab_class(slab, 1);
+	if (slab_class == NULL)
+		return 0;
+
+	if (slab_overflow_detection(slab) != 0) {
+		mutex_unlock(&(slab_class->mutex));
+		exit(EXIT_FAILURE);
+	}
+
+	size_t slots_nb = slab->slots_nb;
+	mutex_unlock(&(slab_class->mutex));
+	return slots_nb;
+}
+
+/**
+ * La fonction scan_time_budget_exceeded() indique si la durée écoulée depuis start_time a atteint scan_time_budget.
+ */
+static int scan_time_budget_exceeded(struct timespec *start_time) {
+	struct timespec current_time;
+	clock_gettime(CLOCK_MONOTONIC, &current_time);
+	size_t elapsed_time = (current_time.tv_sec - start_time->tv_sec) * 1000000 + (current_time.tv_nsec - start_time->tv_nsec) / 1000;
+	return elapsed_time >= scan_time_budget;
+}
+
 void *dynamic_overflow_detection(void *arg) {
 	(void) arg;
 
+	// Position (arène et indice du bloc de métadonnées, indice du slab) à partir de laquelle le prochain passage reprend
+	size_t arena_cursor = 0;
+	size_t meta_information_cursor = 0;
+	size_t slab_cursor = 0;
+
 	while (1) {
-		struct meta_information *result = metadata_array_map(meta_information_pool_root, 1, overflow_detection, NULL, 0, 0);
-		if (result != NULL) {
-			LOG_ERROR("Detection d'overflow : bloc mémoire commençant à l'adresse %p, (l'adresse du bloc de metadonnees concerne est %p) \n", result->data_ptr, result);
-			mutex_unlock(&(result->mutex));
-			exit (EXIT_FAILURE);
+		struct timespec start_time;
+		clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+		for (size_t i = 0; i < arenas_nb; i++) {
+			if (!__atomic_load_n(&(arenas[i].initialized), __ATOMIC_ACQUIRE))
+				continue;
+
+			for (size_t j = 0; j < RECENT_BLOCKS_NB; j++) {
+				struct meta_information *recent_block = __atomic_load_n(&(arenas[i].recent_blocks[j]), __ATOMIC_RELAXED);
+				if (recent_block != NULL)
+					scan_block(recent_block);
+			}
+		}
+
+		// Chaque arène est parcourue au plus une fois par passage
+		size_t visited_arenas_nb = 0;
+		for (size_t checked_nb = 0; checked_nb < scan_batch_size && visited_arenas_nb < arenas_nb; checked_nb++) {
+			struct arena *arena = &arenas[arena_cursor];
+			if (!__atomic_load_n(&(arena->initialized), __ATOMIC_ACQUIRE)
+					|| meta_information_cursor >= arena->meta_information_pool_size / sizeof(struct meta_information)) {
+				arena_cursor = (arena_cursor + 1) % arenas_nb;
+				meta_information_cursor = 0;
+				visited_arenas_nb++;
+				continue;
+			}
+
+			scan_block(&(arena->meta_information_pool_root[meta_information_cursor]));
+			meta_information_cursor++;
+
+			// La durée du passage est vérifiée régulièrement (et non après chaque bloc)
+			if (checked_nb % 64 == 63 && scan_time_budget_exceeded(&start_time))
+				break;
+		}
+
+		// Les slabs sont parcourus de la même manière (un emplacement compte pour un bloc), dans la limite du même budget de temps
+		// (un slab contient au plus SLAB_SLOTS_MAX_NB emplacements : la durée est vérifiée avant chaque slab)
+		size_t slabs_nb = slabs_enabled ? __atomic_load_n(&(slab_pool.slabs_nb), __ATOMIC_ACQUIRE) : 0;
+		for (size_t checked_nb = 0, visited_slabs_nb = 0; checked_nb < scan_batch_size && visited_slabs_nb < slabs_nb; visited_slabs_nb++) {
+			if (scan_time_budget_exceeded(&start_time))
+				break;
+
+			slab_cursor = (slab_cursor + 1) % slabs_nb;
+			checked_nb += scan_slab(slab_cursor);
+		}
+
+		// Statistiques demandées à l'aide du signal stats_signal
+		if (__atomic_exchange_n(&stats_dump_requested, 0, __ATOMIC_RELAXED))
+			stats_dump(STDERR_FILENO);
+
+		// int usleep(useconds_t usec);
+		usleep(scan_interval * 1000);
+	}
+}
+
+/* ****************************************************************** */
+/* *************** VÉRIFICATION DE L'INTÉGRITÉ DU TAS *************** */
+/* ****************************************************************** */
+
+/**
+ * La fonction check_meta_information_struct() vérifie le canari du bloc de données d'un bloc de métadonnées,
+ * ainsi que la cohérence de son chaînage avec le bloc suivant (le bloc suivant pointe vers lui, appartient
+ * à la même arène, et son bloc de données suit immédiatement le canari). Elle renvoie le nombre d'incohérences.
+ */
+size_t check_meta_information_struct(struct meta_information *meta_information_element) {
+	size_t errors_nb = 0;
+
+	spinlock_lock(&(meta_information_element->lock));
+	if (meta_information_element->status == UNUSED) {
+		spinlock_unlock(&(meta_information_element->lock));
+		return 0;
+	}
+
+	if (overflow_detection(meta_information_element, NULL)) {
+		LOG_ERROR("secmalloc_check() : detection d'overflow : bloc mémoire commençant à l'adresse %p (l'adresse du bloc de metadonnees concerne est %p) \n",
+				meta_information_element->data_ptr, meta_information_element);
+		errors_nb++;
+	}
+
+	// Le verrou du bloc suivant est pris après celui du bloc (ordre de la liste chaînée)
+	struct meta_information *next_meta_information_element = meta_information_element->next;
+	if (next_meta_information_element != NULL) {
+		spinlock_lock(&(next_meta_information_element->lock));
+
+		if (next_meta_information_element->prev != meta_information_element || next_meta_information_element->status == UNUSED
+				|| next_meta_information_element->arena != meta_information_element->arena
+				|| (size_t) next_meta_information_element->data_ptr != (size_t) meta_information_element->data_ptr
+					+ meta_information_element->size + sizeof(struct struct_canary)) {
+			LOG_ERROR("secmalloc_check() : chainage incoherent entre les blocs de metadonnees %p et %p \n",
+					meta_information_element, next_meta_information_element);
+			errors_nb++;
+		}
+
+		spinlock_unlock(&(next_meta_information_element->lock));
+	}
+
+	spinlock_unlock(&(meta_information_element->lock));
+	return errors_nb;
+}
+
+/**
+ * La fonction heap_check() vérifie la tranche d'indice worker->index (parmi worker->workers_nb tranches)
+ * du pool de meta-information de chaque arène. Le nombre d'incohérences détectées est placé dans worker->errors_nb.
+ */
+void *heap_check(void *arg) {
+	struct heap_check_worker *worker = (struct heap_check_worker *) arg;
+	worker->errors_nb = 0;
+
+	for (size_t i = 0; i < arenas_nb; i++) {
+		if (!__atomic_load_n(&(arenas[i].initialized), __ATOMIC_ACQUIRE))
+			continue;
+
+		// Les blocs de métadonnées ajoutés pendant la vérification (élargissement du pool) ne sont pas vérifiés
+		size_t meta_information_nb = arenas[i].meta_information_pool_size / sizeof(struct meta_information);
+		size_t slice_size = (meta_information_nb + worker->workers_nb - 1) / worker->workers_nb;
+		size_t first_index = worker->index * slice_size;
+		size_t last_index = (first_index + slice_size < meta_information_nb) ? first_index + slice_size : meta_information_nb;
+
+		for (size_t j = first_index; j < last_index; j++)
+			worker->errors_nb += check_meta_information_struct(&(arenas[i].meta_information_pool_root[j]));
+	}
+
+	// Les slabs sont partagés de la même manière
+	size_t slabs_nb = slabs_enabled ? __atomic_load_n(&(slab_pool.slabs_nb), __ATOMIC_ACQUIRE) : 0;
+	for (size_t i = worker->index; i < slabs_nb; i += worker->workers_nb) {
+		struct slab_class *slab_class = lock_slab_class(&(slab_pool.descriptors[i]), 0);
+		if (slab_class == NULL)
+			continue;
+
+		worker->errors_nb += slab_overflow_detection(&(slab_pool.descriptors[i]));
+		mutex_unlock(&(slab_class->mutex));
+	}
+
+	return NULL;
+}
+
+/* ****************************************************************** */
+/* ************************* STATISTIQUES *************************** */
+/* ****************************************************************** */
+
+void init_stats() {
+	// int pthread_key_create(pthread_key_t *key, void (*destructor)(void*));
+	int pthread_key_create_result = pthread_key_create(&thread_stats_key, thread_stats_release);
+	if (pthread_key_create_result != 0)
+		handle_errnum("pthread_key_create()", pthread_key_create_result);
+
+	// MSM_STATS_SIGNAL : numéro du signal qui provoque l'écriture des statistiques sur la sortie d'erreur
+	const char *stats_signal_str = getenv("MSM_STATS_SIGNAL");
+	if (stats_signal_str != NULL && strtoul(stats_signal_str, NULL, 10) > 0) {
+		unsigned long signal_number = strtoul(stats_signal_str, NULL, 10);
+
+		// SIGUSR1 termine le programme lors d'un double free ou d'une libération invalide, SIGSEGV et SIGBUS lors d'un accès
+		// à une page de garde : ils ne doivent pas être interceptés. SIGKILL et SIGSTOP ne peuvent pas l'être.
+		if (signal_number >= NSIG || signal_number == SIGUSR1 || signal_number == SIGKILL || signal_number == SIGSTOP
+				|| signal_number == SIGSEGV || signal_number == SIGBUS) {
+			LOG_ERROR("MSM_STATS_SIGNAL : le signal %lu ne peut pas etre utilise, l'ecriture des statistiques est desactivee \n", signal_number);
+			return;
+		}
+		stats_signal = (int) signal_number;
+
+		struct sigaction action;
+		memset(&action, 0, sizeof(action));
+		action.sa_handler = stats_signal_handler;
+		sigemptyset(&(action.sa_mask));
+		action.sa_flags = SA_RESTART;
+
+		// int sigaction(int signum, const struct sigaction *act, struct sigaction *oldact);
+		if (sigaction(stats_signal, &action, NULL) != 0) {
+			LOG_ERROR("MSM_STATS_SIGNAL : echec de la fonction sigaction() pour le signal %d, l'ecriture des statistiques est desactivee \n", stats_signal);
+			stats_signal = 0;
+		}
+	}
+}
+
+/**
+ * La fonction stats_signal_handler() est appelée à la réception du signal stats_signal. Les fonctions
+ * qui écrivent les statistiques ne peuvent pas être appelées depuis un gestionnaire de signal :
+ * les statistiques sont écrites lors du prochain passage du thread de parcours du tas.
+ */
+void stats_signal_handler(int signal_number) {
+	(void) signal_number;
+	__atomic_store_n(&stats_dump_requested, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * La fonction get_thread_stats() renvoie les compteurs du thread appelant. Lors du premier appel par un thread,
+ * les compteurs d'un thread terminé sont repris s'il en existe, sinon de nouveaux compteurs sont créés.
+ */
+struct thread_stats *get_thread_stats() {
+	if (thread_stats != NULL)
+		return thread_stats;
+
+	pthread_init_once();
+
+	struct thread_stats *stats = __atomic_load_n(&thread_stats_list, __ATOMIC_ACQUIRE);
+	for (; stats != NULL; stats = stats->next) {
+		int released = 1;
+		if (__atomic_compare_exchange_n(&(stats->released), &released, 0, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			break;
+	}
+
+	if (stats == NULL) {
+		// Le contenu du mappage est initialisé à zéro
+		stats = (struct thread_stats *) map_memeory(NULL, sizeof(struct thread_stats));
+		stats->next = __atomic_load_n(&thread_stats_list, __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&thread_stats_list, &(stats->next), stats, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+
+	// int pthread_setspecific(pthread_key_t key, const void *value);
+	pthread_setspecific(thread_stats_key, stats);
+	thread_stats = stats;
+	return stats;
+}
+
+/**
+ * La fonction thread_stats_release() est le destructeur de thread_stats_key : les compteurs
+ * d'un thread qui se termine peuvent ensuite être repris par un autre thread.
+ */
+void thread_stats_release(void *stats) {
+	thread_stats = NULL;
+	__atomic_store_n(&(((struct thread_stats *) stats)->released), 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * La fonction stats_count() incrémente le compteur counter du thread appelant, ainsi que le nombre
+ * d'allocations de la classe de taille de size pour STATS_ALLOCATIONS.
+ */
+void stats_count(int counter, size_t size) {
+	struct thread_stats *stats = get_thread_stats();
+
+	// Seul le thread modifie ses compteurs : une écriture atomique (sans lecture-modification-écriture atomique)
+	// suffit pour que secmalloc_stats() ne lise jamais une valeur partiellement écrite
+	__atomic_store_n(&(stats->counters[counter]), stats->counters[counter] + 1, __ATOMIC_RELAXED);
+
+	if (counter == STATS_ALLOCATIONS) {
+		size_t index = get_free_list_index(size);
+		__atomic_store_n(&(stats->size_classes[index]), stats->size_classes[index] + 1, __ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * La fonction add_block_stats() ajoute un bloc de métadonnées (dont le verrou est détenu par l'appelant)
+ * aux statistiques pointées par stats.
+ */
+int add_block_stats(struct meta_information *meta_information_element, void *stats) {
+	struct secmalloc_stats *heap_stats = (struct secmalloc_stats *) stats;
+
+	switch (meta_information_element->status) {
+		case BUSY:
+			heap_stats->live_bytes += meta_information_element->size;
+			heap_stats->busy_blocks_nb++;
+			break;
+
+		case FREE:
+		case CACHED:
+		case WIPING:
+			heap_stats->free_bytes += meta_information_element->size;
+			heap_stats->free_blocks_nb++;
+			if (meta_information_element->size > heap_stats->largest_free_block)
+				heap_stats->largest_free_block = meta_information_element->size;
+			break;
+
+		case MAPPED:
+			heap_stats->live_bytes += meta_information_element->size;
+			heap_stats->mapped_bytes += get_delta_size(meta_information_element->size + sizeof(struct struct_canary));
+			heap_stats->mapped_blocks_nb++;
+			break;
+
+		case GUARDED:
+			heap_stats->live_bytes += meta_information_element->size;
+			heap_stats->mapped_bytes += page_size;
+			heap_stats->guarded_blocks_nb++;
+			break;
+
+		default:
+			break;
+	}
+
+	return 0;
+}
+
+/**
+ * La fonction stats_dump() écrit les statistiques de l'allocateur, sous forme de texte, dans file_descriptor.
+ */
+void stats_dump(int file_descriptor) {
+	struct secmalloc_stats stats;
+	secmalloc_stats(&stats);
+
+	char text[LOG_RECORD_MAX_SIZE];
+	int text_size = snprintf(text, sizeof(text),
+			"secmalloc : %lu octets mappes, %lu octets occupes, %lu octets libres, %lu octets de metadonnees \n"
+			"secmalloc : plus grand bloc libre %lu octets, %lu blocs occupes, %lu blocs libres, %lu grandes allocations, "
+			"%lu allocations echantillonnees \n"
+			"secmalloc : %lu allocations, %lu liberations, %lu appels a my_calloc(), %lu appels a my_realloc() \n"
+			"secmalloc : %lu octets du tas en pages de grande taille, %lu octets de slabs, %lu emplacements de slabs occupes \n",
+			stats.mapped_bytes, stats.live_bytes, stats.free_bytes, stats.metadata_bytes,
+			stats.largest_free_block, stats.busy_blocks_nb, stats.free_blocks_nb, stats.mapped_blocks_nb,
+			stats.guarded_blocks_nb, stats.allocations_nb, stats.frees_nb, stats.calloc_calls_nb, stats.realloc_calls_nb,
+			stats.huge_page_bytes, stats.slab_bytes, stats.slab_slots_nb);
+
+	for (size_t i = 0; i < SECMALLOC_SIZE_CLASSES_NB && text_size > 0 && (size_t) text_size < sizeof(text); i++) {
+		if (stats.size_classes[i] != 0)
+			text_size += snprintf(text + text_size, sizeof(text) - (size_t) text_size,
+					"secmalloc : %lu allocations de %lu a %lu octets \n", stats.size_classes[i], (size_t) 1 << i, ((size_t) 1 << i << 1) - 1);
+	}
+
+	if (text_size > 0)
+		// ssize_t write (int fd, const void *buffer, size_t size)
+		write(file_descriptor, text, ((size_t) text_size < sizeof(text)) ? (size_t) text_size : sizeof(text) - 1);
+}
+
+/**
+ * La fonction is_in_data_pool() indique si address appartient à la zone réservée pour le pool de data d'une arène.
+ */
+int is_in_data_pool(size_t address) {
+	for (size_t i = 0; i < arenas_nb; i++) {
+		if (!__atomic_load_n(&(arenas[i].initialized), __ATOMIC_ACQUIRE) || arenas[i].data_pool == NULL)
+			continue;
+
+		if (address >= (size_t) arenas[i].data_pool && address < (size_t) arenas[i].data_pool + DATA_POOL_RESERVED_SIZE)
+			return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * La fonction get_huge_page_bytes() renvoie le nombre d'octets des pools de data qui sont effectivement soutenus
+ * par des pages transparentes de grande taille, en additionnant le champ AnonHugePages des zones de /proc/self/smaps
+ * situées dans un pool de data. Le fichier est lu avec read() dans un tampon de la pile, sans allouer de mémoire.
+ */
+size_t get_huge_page_bytes() {
+	int file_descriptor = open("/proc/self/smaps", O_RDONLY);
+	if (file_descriptor == -1)
+		return 0;
+
+	char buffer[4096];
+	size_t buffer_size = 0;
+	size_t huge_page_bytes = 0;
+	int in_data_pool = 0;
+	ssize_t read_size;
+
+	while ((read_size = read(file_descriptor, buffer + buffer_size, sizeof(buffer) - 1 - buffer_size)) > 0) {
+		buffer_size += (size_t) read_size;
+
+		size_t line_start = 0;
+		for (size_t i = 0; i < buffer_size; i++) {
+			if (buffer[i] != '\n')
+				continue;
+
+			buffer[i] = '\0';
+			char *line = buffer + line_start;
+			char *end_ptr;
+
+			// Une zone commence par une ligne "debut-fin permissions ..." (adresses en hexadécimal),
+			// suivie d'une ligne "Champ: valeur kB" par compteur
+			unsigned long start_address = strtoul(line, &end_ptr, 16);
+			if (end_ptr != line && *end_ptr == '-')
+				in_data_pool = is_in_data_pool(start_address);
+			else if (in_data_pool && strncmp(line, "AnonHugePages:", 14) == 0)
+				huge_page_bytes += strtoul(line + 14, NULL, 10) * 1024;
+
+			line_start = i + 1;
 		}
 
-		sleep(1);
+		// La ligne incomplète est conservée pour la lecture suivante (une ligne trop longue est ignorée)
+		buffer_size -= line_start;
+		memmove(buffer, buffer + line_start, buffer_size);
+		if (buffer_size == sizeof(buffer) - 1)
+			buffer_size = 0;
 	}
+
+	close(file_descriptor);
+	return huge_page_bytes;
 }
 
 /* ****************************************************************** */
@@ -55,13 +508,47 @@ void init_logs_file_descriptor() {
 			// int open(const char *pathname, int flags [, mode_t mode]);
 			// 0666 & ~022 = 0644 <=> rw-r--r--
 			int open_result = open(logs_file_path, O_CREAT | O_WRONLY, 0666);
-			if (open_result != -1)
+			if (open_result != -1) {
+				// Les messages émis pendant l'initialisation du journal asynchrone sont ignorés
+				logs_file_descriptor = -2;
+				init_log_flusher();
 				logs_file_descriptor = open_result;
-			else
+
+				// MSM_TRACE : enregistrement de chaque appel à malloc(), free(), calloc() et realloc() (bibliothèque dynamique)
+				const char *trace_str = getenv("MSM_TRACE");
+				trace_enabled = (trace_str != NULL && strtoul(trace_str, NULL, 10) != 0);
+			} else {
 				logs_file_descriptor = STDOUT_FILENO;
+			}
 		} else {
 			logs_file_descriptor = -2;
 		}
+
+		init_log_level();
+	}
+}
+
+void init_log_level() {
+	if (logs_file_descriptor < 0) {
+		log_level = LOG_LEVEL_NONE;
+		return;
+	}
+
+	// MSM_LOG_LEVEL : error, info, debug, trace, ou le numéro du niveau
+	const char *log_level_str = getenv("MSM_LOG_LEVEL");
+	const char *log_level_names[] = { "none", "error", "info", "debug", "trace" };
+
+	log_level = LOG_LEVEL_DEBUG;
+	if (log_level_str != NULL) {
+		char *end_ptr;
+		unsigned long level = strtoul(log_level_str, &end_ptr, 10);
+		if (end_ptr != log_level_str && *end_ptr == '\0' && level <= LOG_LEVEL_TRACE)
+			log_level = (int) level;
+
+		for (int i = LOG_LEVEL_NONE; i <= LOG_LEVEL_TRACE; i++) {
+			if (strcmp(log_level_str, log_level_names[i]) == 0)
+				log_level = i;
+		}
 	}
 }
 
@@ -71,10 +558,118 @@ int get_logs_file_descriptor() {
 	return logs_file_descriptor;
 }
 
+void init_thread_cache() {
+	// Le cache par thread est activé en indiquant, dans la variable d'environnement MSM_THREAD_CACHE,
+	// le nombre maximal de blocs libérés conservés par case du cache de chaque thread
+	const char *thread_cache_capacity_str = getenv("MSM_THREAD_CACHE");
+	if (thread_cache_capacity_str != NULL) {
+		// unsigned long strtoul(const char *nptr, char **endptr, int base);
+		thread_cache_capacity = strtoul(thread_cache_capacity_str, NULL, 10);
+	}
+
+	// int pthread_key_create(pthread_key_t *key, void (*destructor)(void*));
+	// Lorsqu'un thread se termine, destructor est appelé avec la valeur associée à la clé (si elle n'est pas NULL)
+	int pthread_key_create_result = pthread_key_create(&thread_cache_key, thread_cache_flush);
+	if (pthread_key_create_result != 0)
+		handle_errnum("pthread_key_create()", pthread_key_create_result);
+}
+
+void init_mmap_threshold() {
+	// Le seuil au-delà duquel une allocation dispose de son propre mappage peut être indiqué
+	// (en octets) dans la variable d'environnement MSM_MMAP_THRESHOLD
+	const char *mmap_threshold_str = getenv("MSM_MMAP_THRESHOLD");
+	if (mmap_threshold_str != NULL) {
+		// unsigned long strtoul(const char *nptr, char **endptr, int base);
+		mmap_threshold = strtoul(mmap_threshold_str, NULL, 10);
+	}
+
+	if (mmap_threshold > MMAP_THRESHOLD_MAX) {
+		LOG("MSM_MMAP_THRESHOLD est ramene a %lu octets \n", MMAP_THRESHOLD_MAX);
+		mmap_threshold = MMAP_THRESHOLD_MAX;
+	}
+}
+
+void init_huge_pages() {
+	// Les pools de data sont soutenus par des pages de grande taille si la variable d'environnement
+	// MSM_HUGE_PAGES est différente de 0
+	const char *huge_pages_str = getenv("MSM_HUGE_PAGES");
+	if (huge_pages_str != NULL) {
+		// unsigned long strtoul(const char *nptr, char **endptr, int base);
+		huge_pages_enabled = (strtoul(huge_pages_str, NULL, 10) != 0);
+	}
+}
+
+void init_slabs() {
+	// Les petites allocations sont placées dans des slabs si la variable d'environnement MSM_SLABS est différente de 0
+	const char *slabs_str = getenv("MSM_SLABS");
+	if (slabs_str != NULL) {
+		// unsigned long strtoul(const char *nptr, char **endptr, int base);
+		slabs_enabled = (strtoul(slabs_str, NULL, 10) != 0);
+	}
+
+	if (!slabs_enabled)
+		return;
+
+	// Aucun slab n'est accessible tant qu'il n'a pas été créé
+	slab_pool.slabs = (char *) reserve_memeory(SLAB_POOL_RESERVED_SIZE);
+	slab_pool.descriptors = (struct slab *) reserve_memeory(SLAB_DESCRIPTORS_RESERVED_SIZE);
+	slab_pool.slabs_nb = 0;
+	slab_pool.slabs_committed_size = 0;
+	slab_pool.descriptors_committed_size = 0;
+	slab_pool.empty_slabs = NULL;
+	mutex_init(&(slab_pool.mutex), 0);
+}
+
+void init_guard_pool() {
+	// L'échantillonnage est activé en indiquant, dans la variable d'environnement MSM_GUARD_SAMPLE_RATE,
+	// le nombre N tel qu'une allocation sur N (de chaque thread) est placée contre une page de garde
+	const char *guard_sample_rate_str = getenv("MSM_GUARD_SAMPLE_RATE");
+	if (guard_sample_rate_str != NULL) {
+		// unsigned long strtoul(const char *nptr, char **endptr, int base);
+		guard_sample_rate = strtoul(guard_sample_rate_str, NULL, 10);
+	}
+
+	if (guard_sample_rate == 0)
+		return;
+
+	// Aucune page n'est accessible tant qu'aucun emplacement n'est utilisé
+	guard_pool.slots = (char *) reserve_memeory(GUARD_POOL_SLOTS_NB * 2 * page_size);
+	memset(guard_pool.used_slots, 0, sizeof(guard_pool.used_slots));
+	guard_pool.next_slot = 0;
+	mutex_init(&(guard_pool.mutex), 0);
+}
+
+void init_deferred_wipe() {
+	// Le nettoyage différé est activé en indiquant, dans la variable d'environnement MSM_DEFERRED_WIPE,
+	// la taille minimale (en octets) des blocs libérés dont le nettoyage est confié au thread de nettoyage
+	const char *deferred_wipe_min_size_str = getenv("MSM_DEFERRED_WIPE");
+	if (deferred_wipe_min_size_str != NULL) {
+		// unsigned long strtoul(const char *nptr, char **endptr, int base);
+		deferred_wipe_min_size = strtoul(deferred_wipe_min_size_str, NULL, 10);
+	}
+
+	wipe_queue.head = NULL;
+	wipe_queue.size = 0;
+	mutex_init(&(wipe_queue.mutex), 0);
+
+	// int pthread_cond_init(pthread_cond_t *cond, const pthread_condattr_t *attr);
+	int pthread_cond_init_result = pthread_cond_init(&(wipe_queue.cond), NULL);
+	if (pthread_cond_init_result != 0)
+		handle_errnum("pthread_cond_init()", pthread_cond_init_result);
+}
+
 long get_canary() {
 	return (long) clean;
 }
 
+/**
+ * La fonction get_guard_slack_byte() renvoie la valeur de l'octet d'adresse address du motif qui sépare
+ * la fin des données d'une allocation échantillonnée de sa page de garde.
+ */
+unsigned char get_guard_slack_byte(size_t address) {
+	return (unsigned char) ((((size_t) get_canary() ^ address) * 0x9E3779B97F4A7C15UL) >> 56);
+}
+
 void init_page_size() {
 	if (page_size == 0) {
 		// long int sysconf (int parameter)
@@ -94,28 +689,47 @@ size_t get_page_size() {
 	return page_size;
 }
 
+// Les fonctions suivantes concernent l'arène principale (la première arène, initialisée par init())
+
 struct struct_canary *get_data_pool() {
-	if (data_pool == NULL)
+	if (arenas[0].data_pool == NULL)
 		pthread_init_once();
-	return data_pool;
+	return arenas[0].data_pool;
 }
 
 struct meta_information *get_meta_information_pool_root() {
-	if (meta_information_pool_root == NULL)
+	if (arenas[0].meta_information_pool_root == NULL)
 		pthread_init_once();
-	return meta_information_pool_root;
+	return arenas[0].meta_information_pool_root;
 }
 
 size_t get_data_pool_size() {
-	if (data_pool_size == 0)
+	if (arenas[0].data_pool_size == 0)
 		pthread_init_once();
-	return data_pool_size;
+	return arenas[0].data_pool_size;
 }
 
 size_t get_meta_information_pool_size() {
-	if (meta_information_pool_size == 0)
+	if (arenas[0].meta_information_pool_size == 0)
+		pthread_init_once();
+	return arenas[0].meta_information_pool_size;
+}
+
+/**
+ * La fonction get_thread_arena() renvoie l'arène du thread appelant. Lors du premier appel par un thread,
+ * une arène lui est attribuée à tour de rôle (et initialisée si aucun thread ne l'utilisait encore).
+ */
+struct arena *get_thread_arena() {
+	if (thread_arena == NULL) {
 		pthread_init_once();
-	return meta_information_pool_size;
+
+		size_t index = __atomic_fetch_add(&next_arena_index, 1, __ATOMIC_RELAXED) % arenas_nb;
+		init_arena(&arenas[index]);
+		thread_arena = &arenas[index];
+		LOG("Le thread utilise l'arene %lu \n", index);
+	}
+
+	return thread_arena;
 }
 
 /* ****************************************************************** */
@@ -184,7 +798,7 @@ void mutex_destroy(pthread_mutex_t *mutex_ptr) {
 }
 
 void mutex_lock(pthread_mutex_t *mutex_ptr) {
-	DEBUG("lock %p \n", mutex_ptr);
+	TRACE("lock %p \n", mutex_ptr);
 
 	// int pthread_mutex_lock(pthread_mutex_t *mutex);
 	int mutex_lock_result = pthread_mutex_lock(mutex_ptr);
@@ -193,7 +807,7 @@ void mutex_lock(pthread_mutex_t *mutex_ptr) {
 }
 
 int mutex_trylock(pthread_mutex_t *mutex_ptr) {
-	DEBUG("try lock %p \n", mutex_ptr);
+	TRACE("try lock %p \n", mutex_ptr);
 
 	// int pthread_mutex_trylock(pthread_mutex_t *mutex);
 	int mutex_trylock_result = pthread_mutex_trylock(mutex_ptr);
@@ -211,7 +825,7 @@ int mutex_trylock(pthread_mutex_t *mutex_ptr) {
 }
 
 void mutex_unlock(pthread_mutex_t *mutex_ptr) {
-	DEBUG("unlock %p \n", mutex_ptr);
+	TRACE("unlock %p \n", mutex_ptr);
 
 	// int pthread_mutex_unlock(pthread_mutex_t *mutex);
 	int mutex_unlock_result = pthread_mutex_unlock(mutex_ptr);
@@ -219,6 +833,41 @@ void mutex_unlock(pthread_mutex_t *mutex_ptr) {
 		handle_errnum("pthread_mutex_unlock()", mutex_unlock_result);
 }
 
+// Les blocs de métadonnées sont protégés par des verrous tournants (spinlocks), bien plus petits qu'un mutex
+// et qui ne nécessitent pas d'appel système lorsqu'ils sont libres. En cas de contention, l'attente entre deux
+// tentatives double à chaque échec (backoff exponentiel), puis le thread cède le processeur avec sched_yield()
+// afin de ne pas tourner inutilement lorsque le détenteur du verrou n'est pas en cours d'exécution.
+
+void spinlock_init(struct spinlock *lock) {
+	__atomic_store_n(&(lock->locked), 0, __ATOMIC_RELEASE);
+}
+
+void spinlock_lock(struct spinlock *lock) {
+	TRACE("spin lock %p \n", lock);
+
+	unsigned int backoff = 1;
+	while (!spinlock_trylock(lock)) {
+		if (backoff <= SPINLOCK_MAX_BACKOFF) {
+			for (unsigned int i = 0; i < backoff; i++)
+				cpu_relax();
+			backoff *= 2;
+		} else {
+			// int sched_yield(void);
+			sched_yield();
+		}
+	}
+}
+
+int spinlock_trylock(struct spinlock *lock) {
+	// Le verrou n'est écrit (exchange) que s'il semble libre, afin de ne pas invalider inutilement la ligne de cache
+	return !__atomic_load_n(&(lock->locked), __ATOMIC_RELAXED) && !__atomic_exchange_n(&(lock->locked), 1, __ATOMIC_ACQUIRE);
+}
+
+void spinlock_unlock(struct spinlock *lock) {
+	TRACE("spin unlock %p \n", lock);
+	__atomic_store_n(&(lock->locked), 0, __ATOMIC_RELEASE);
+}
+
 /* ****************************************************************** */
 /* **************** FONCTIONS AUXILIAIRES GÉNÉRALES ***************** */
 /* ****************************************************************** */
@@ -317,119 +966,618 @@ void add_log(const char *string_format, int file_descriptor, ...) { // '...' est
 	}
 }
 
-/**
- * La fonction get_delta_size() renvoie le nombre de pages qu'il faut ajouter à la mémoire afin de stocker
- * additional_memory_size octets supplémentaires. Ce calcul permet d'augmenter la mémoire en utilisant
- * une quantité qui est un multiple de la taille d'une page (taille alignée sur l'adresse d'une page).
- */
-size_t get_delta_size(size_t additional_memory_size) {
-	// Si le reste de la division additional_memory_size / PAGE_SIZE est supérieur à zéro,
-	// cela signifie qu'une page supplémentaire doit être ajoutée
-	// Exemple (avec la console de Python) : (4097 % 4096) = 1, ((4097)//4096 + (4097) % 4096) = 2
-	size_t number_of_pages = ((additional_memory_size / page_size) + ((additional_memory_size % page_size != 0) ? 1 : 0));
-	size_t delta_size =  number_of_pages * page_size;
-
-	return delta_size;
-}
-
-
 /* ****************************************************************** */
-/* ********* CRÉATION ET ÉLARGISSEMENT DE MAPPAGE DE MÉMOIRE ******** */
+/* ********************** JOURNAL ASYNCHRONE ************************ */
 /* ****************************************************************** */
 
-void	*remap_memeory(void *memeory_to_realloc, size_t memeory_old_size, size_t delta_size) {
-	// void *mremap(void *old_address, size_t old_size, size_t new_size, int flags);
-	// mremap() étend (ou réduit) un mappage de mémoire existant.
-	// En cas de succès, mremap() renvoie un pointeur vers la nouvelle zone de mémoire virtuelle.
-	// En cas d'erreur, la valeur MAP_FAILED est renvoyée.
+void init_log_flusher() {
+	log_flusher.rings = NULL;
+	memset(log_flusher.known_formats, 0, sizeof(log_flusher.known_formats));
+	mutex_init(&(log_flusher.mutex), 0);
 
-	// MREMAP_MAYMOVE : Par défaut, s'il n'y a pas suffisamment d'espace pour développer un mappage à son emplacement actuel,
-	// alors mremap() échoue. Si cet indicateur est spécifié, alors le noyau est autorisé à déplacer le mappage vers une
-	// nouvelle adresse virtuelle, si nécessaire. Si le mappage est déplacé, les pointeurs absolus vers l'ancien emplacement
-	// de mappage deviennent invalides (des décalages par rapport à l'adresse de départ du mappage doivent être utilisés).
+	// int pthread_key_create(pthread_key_t *key, void (*destructor)(void*));
+	int pthread_key_create_result = pthread_key_create(&(log_flusher.ring_key), log_ring_release);
+	if (pthread_key_create_result != 0)
+		handle_errnum("pthread_key_create()", pthread_key_create_result);
 
-	// Source : Linux manual page
-	struct struct_canary* mremap_result = mremap(memeory_to_realloc, memeory_old_size, memeory_old_size + delta_size,  MREMAP_MAYMOVE);
-	if (mremap_result == MAP_FAILED) {
-		handle_error("Echec de la fonction mremap()");
-	}
-
-	return mremap_result;
+	log_flusher.buffer = (char *) map_memeory(NULL, LOG_FLUSH_BUFFER_SIZE);
 }
 
-void	*init_memeory(void *memeory_to_init, void *address) {
-	if (memeory_to_init == NULL) {
-		// void *mmap(void addr, size_t length, int prot, int flags, int fd, off_t offset);
-		// mmap() crée un nouveau mappage dans l'espace d'adressage virtuel du processus appelant.
-		// L'adresse du nouveau mappage est renvoyée à la suite de l'appel.
-		// En cas d'erreur, la valeur MAP_FAILED est renvoyée
-
-		// MAP_ANON : synonyme de MAP_ANONYMOUS ; fourni pour la compatibilité avec d’autres implémentations.
-		// MAP_ANONYMOUS : Le mappage n'est soutenu par aucun fichier ; son contenu est initialisé à zéro.
-		//            	   L'argument fd est ignoré ; cependant, certaines implémentations exigent que fd soit -1
-		//                 si MAP_ANONYMOUS (ou MAP_ANON) est spécifié. L'argument offset doit être nul.
+/**
+ * La fonction get_thread_log_ring() renvoie le tampon du journal du thread appelant. Lors du premier appel par un thread,
+ * le tampon d'un thread terminé est repris s'il en existe un, sinon un nouveau tampon est créé.
+ * La fonction renvoie NULL si la création du tampon a échoué.
+ */
+struct log_ring *get_thread_log_ring() {
+	if (thread_log_ring != NULL)
+		return thread_log_ring;
+
+	struct log_ring *log_ring = __atomic_load_n(&(log_flusher.rings), __ATOMIC_ACQUIRE);
+	for (; log_ring != NULL; log_ring = log_ring->next) {
+		int released = 1;
+		if (__atomic_compare_exchange_n(&(log_ring->released), &released, 0, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			break;
+	}
 
-		// MAP_PRIVATE : Créer un mappage copy-on-write privé.
-		//               Les mises à jour du mappage ne sont pas visibles par les autres processus
-		// PROT_READ : les pages peuvent être lues ; PROT_WRITE : les pages peuvent être écrites.
+	if (log_ring == NULL) {
+		// map_memeory() n'est pas utilisée : en cas d'échec, handle_error() écrirait dans le journal
+		void *mmap_result = mmap(NULL, sizeof(struct log_ring), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+		if (mmap_result == MAP_FAILED)
+			return NULL;
 
-		// Source : Linux manual page
-		memeory_to_init = mmap(address, get_page_size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
-		if (memeory_to_init == MAP_FAILED) {
-			handle_error("Echec de la fonction mmap()");
-		}
+		// Le contenu du mappage est initialisé à zéro
+		log_ring = (struct log_ring *) mmap_result;
+		log_ring->next = __atomic_load_n(&(log_flusher.rings), __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&(log_flusher.rings), &(log_ring->next), log_ring, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
 	}
 
-	return memeory_to_init;
+	// int pthread_setspecific(pthread_key_t key, const void *value);
+	// Le destructeur de ring_key n'est appelé à la fin du thread que si la valeur associée n'est pas NULL
+	pthread_setspecific(log_flusher.ring_key, log_ring);
+	thread_log_ring = log_ring;
+	return log_ring;
 }
 
-void exit_handler() {
-	metadata_linked_list_map(meta_information_pool_root, 1, clean_data, NULL, 1);
-	int munmap_result;
+/**
+ * La fonction log_ring_release() est le destructeur de ring_key, appelé à la fin de chaque thread qui
+ * a écrit dans le journal : le tampon du thread peut ensuite être repris par un autre thread.
+ */
+void log_ring_release(void *log_ring) {
+	thread_log_ring = NULL;
+	__atomic_store_n(&(((struct log_ring *) log_ring)->released), 1, __ATOMIC_RELEASE);
+}
 
-	if (data_pool != NULL) {
-		// int munmap(void *addr, size_t len);
-		munmap_result = munmap(data_pool, data_pool_size);
-		if (munmap_result != 0)
-			handle_error("Echec de la fonction munmap()");
+/**
+ * La fonction log_message() ajoute un message au tampon du journal du thread appelant. Les arguments ne sont
+ * pas mis en forme : l'enregistrement contient l'adresse de la chaîne de format suivie de la valeur des arguments.
+ * Si le fichier des logs n'a pas pu être ouvert, le message est mis en forme et écrit sur la sortie standard.
+ */
+void log_message(int level, const char *string_format, ...) {
+	int file_descriptor = get_logs_file_descriptor();
+	if (file_descriptor < 0 || string_format == NULL || level > log_level)
+		return;
 
-		data_pool = NULL;
-	}
+	va_list ap;
+	va_start(ap, string_format);
 
-	if (meta_information_pool_root != NULL) {
-		munmap_result = munmap(meta_information_pool_root, meta_information_pool_size);
-		if (munmap_result != 0)
-			handle_error("Echec de la fonction munmap()");
+	if (file_descriptor == STDOUT_FILENO) {
+		char text[LOG_RECORD_MAX_SIZE];
+		int text_size = vsnprintf(text, sizeof(text), string_format, ap);
+		va_end(ap);
 
-		meta_information_pool_root = NULL;
+		if (text_size > 0)
+			write(STDOUT_FILENO, text, ((size_t) text_size < sizeof(text)) ? (size_t) text_size : sizeof(text) - 1);
+		return;
 	}
-}
-
-/* ****************************************************************** */
-/* ************************ INITIALISATION ************************** */
-/* ****************************************************************** */
 
-void init() {
-	DEBUG("init() \n");
+	struct log_ring *log_ring = get_thread_log_ring();
+	if (log_ring == NULL) {
+		va_end(ap);
+		return;
+	}
 
-	if (data_pool == NULL && meta_information_pool_root == NULL) {
-		init_logs_file_descriptor();
-		init_page_size();
+	uint64_t record[LOG_RECORD_MAX_SIZE / sizeof(uint64_t)];
+	size_t record_size = log_record_encode((char *) record, string_format, ap);
+	va_end(ap);
 
-		data_pool = init_data_pool();
-		meta_information_pool_root = init_meta_information_pool();
+	log_ring_push(log_ring, record, record_size);
+}
 
-		if (data_pool == NULL || meta_information_pool_root == NULL)
-			handle_error("Echec de l'initialisation de la memoire");
+/**
+ * La fonction log_ring_push() ajoute un enregistrement au tampon log_ring du thread appelant.
+ */
+void log_ring_push(struct log_ring *log_ring, const void *record, size_t record_size) {
+	// Seul le thread d'écriture du journal modifie tail : la place disponible ne peut qu'augmenter.
+	// Si le tampon est plein, le thread vide lui-même les tampons plutôt que de perdre l'enregistrement.
+	size_t head = log_ring->head;
+	size_t tail = __atomic_load_n(&(log_ring->tail), __ATOMIC_ACQUIRE);
+	if (LOG_RING_SIZE - (head - tail) < record_size) {
+		log_flush();
+		tail = __atomic_load_n(&(log_ring->tail), __ATOMIC_ACQUIRE);
+	}
 
-		dynamic_overflow_detection_activated = 0;
-		mutex_init(&dynamic_overflow_detection_activated_mutex, 0);
+	if (LOG_RING_SIZE - (head - tail) < record_size) {
+		__atomic_store_n(&(log_ring->dropped_nb), log_ring->dropped_nb + 1, __ATOMIC_RELAXED);
+		return;
 	}
+
+	log_ring_write(log_ring, head, record, record_size);
+	__atomic_store_n(&(log_ring->head), head + record_size, __ATOMIC_RELEASE);
+}
+
+/**
+ * La fonction trace_operation() ajoute au journal l'enregistrement d'un appel à malloc(), free(), calloc() ou realloc()
+ * (enregistrement des allocations, variable d'environnement MSM_TRACE). Les arguments et le résultat de l'appel sont
+ * conservés, ainsi que la date timestamp : pour qu'un même pointeur ne soit jamais alloué avant d'avoir été libéré
+ * lors du rejeu, la date d'une libération est prise avant l'appel, et celle d'une allocation après l'appel.
+ */
+void trace_operation(int operation, void *ptr, size_t count, size_t size, void *result, uint64_t timestamp) {
+	struct log_ring *log_ring = get_thread_log_ring();
+	if (log_ring == NULL)
+		return;
+
+	if (trace_thread_id == 0)
+		trace_thread_id = __atomic_add_fetch(&trace_threads_nb, 1, __ATOMIC_RELAXED);
+
+	struct trace_record record;
+	record.header.size = sizeof(struct trace_record);
+	record.header.type = LOG_RECORD_TRACE;
+	record.header.format = 0;
+	record.header.timestamp = timestamp;
+	record.operation = (uint32_t) operation;
+	record.thread = trace_thread_id;
+	record.ptr = (uint64_t) (size_t) ptr;
+	record.count = count;
+	record.size = size;
+	record.result = (uint64_t) (size_t) result;
+
+	log_ring_push(log_ring, &record, sizeof(record));
+}
+
+uint64_t get_timestamp() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * La fonction log_record_encode() écrit dans record l'enregistrement d'un message : l'en-tête, puis un mot de 8 octets
+ * par indicateur de conversion de string_format. Une chaîne (%s) est copiée, précédée de sa longueur, et complétée
+ * par des '\0' jusqu'au multiple de 8 octets suivant. La fonction renvoie la taille de l'enregistrement.
+ */
+size_t log_record_encode(char *record, const char *string_format, va_list ap) {
+	struct log_record *header = (struct log_record *) record;
+	header->type = LOG_RECORD_MESSAGE;
+	header->format = (uint64_t) (size_t) string_format;
+	header->timestamp = get_timestamp();
+
+	size_t record_size = sizeof(struct log_record);
+	for (const char *c = string_format; *c != '\0'; c++) {
+		if (*c != '%')
+			continue;
+
+		// Indicateurs, largeur, précision et modificateurs de longueur
+		int long_argument = 0;
+		for (c++; *c != '\0' && strchr("-+ #0123456789.lzh", *c) != NULL; c++)
+			long_argument |= (*c == 'l' || *c == 'z');
+
+		if (*c == '\0')
+			break;
+		if (*c == '%')
+			continue;
+		if (record_size + sizeof(uint64_t) + LOG_STRING_MAX_SIZE > LOG_RECORD_MAX_SIZE)
+			break;
+
+		uint64_t value;
+		if (*c == 's') {
+			const char *string = va_arg(ap, const char *);
+			if (string == NULL)
+				string = "(null)";
+
+			value = strnlen(string, LOG_STRING_MAX_SIZE - 1);
+			memcpy(record + record_size, &value, sizeof(value));
+			record_size += sizeof(value);
+
+			memset(record + record_size, 0, (value + sizeof(uint64_t)) & ~(sizeof(uint64_t) - 1));
+			memcpy(record + record_size, string, value);
+			record_size += (value + sizeof(uint64_t)) & ~(sizeof(uint64_t) - 1);
+			continue;
+		}
+
+		if (*c == 'p') {
+			value = (uint64_t) (size_t) va_arg(ap, void *);
+		} else if (strchr("fFeEgGaA", *c) != NULL) {
+			double double_value = va_arg(ap, double);
+			memcpy(&value, &double_value, sizeof(value));
+		} else if (long_argument) {
+			value = va_arg(ap, unsigned long);
+		} else {
+			value = va_arg(ap, unsigned int);
+		}
+
+		memcpy(record + record_size, &value, sizeof(value));
+		record_size += sizeof(value);
+	}
+
+	header->size = (uint32_t) record_size;
+	return record_size;
+}
+
+void log_ring_write(struct log_ring *log_ring, size_t position, const void *data, size_t size) {
+	size_t offset = position & (LOG_RING_SIZE - 1);
+	size_t first_part_size = (size < LOG_RING_SIZE - offset) ? size : LOG_RING_SIZE - offset;
+
+	memcpy(log_ring->buffer + offset, data, first_part_size);
+	memcpy(log_ring->buffer, (const char *) data + first_part_size, size - first_part_size);
+}
+
+void log_ring_read(struct log_ring *log_ring, size_t position, void *data, size_t size) {
+	size_t offset = position & (LOG_RING_SIZE - 1);
+	size_t first_part_size = (size < LOG_RING_SIZE - offset) ? size : LOG_RING_SIZE - offset;
+
+	memcpy(data, log_ring->buffer + offset, first_part_size);
+	memcpy((char *) data + first_part_size, log_ring->buffer, size - first_part_size);
+}
+
+/**
+ * La fonction log_format_record() écrit dans buffer l'enregistrement qui définit la chaîne de format format,
+ * si celle-ci n'a pas encore été écrite dans le fichier des logs, et renvoie sa taille (0 sinon).
+ */
+size_t log_format_record(char *buffer, uint64_t format) {
+	size_t index = (size_t) (format / sizeof(uint64_t)) % LOG_KNOWN_FORMATS_NB;
+	for (size_t i = 0; i < LOG_KNOWN_FORMATS_NB; i++, index = (index + 1) % LOG_KNOWN_FORMATS_NB) {
+		if (log_flusher.known_formats[index] == format)
+			return 0;
+
+		if (log_flusher.known_formats[index] == 0) {
+			log_flusher.known_formats[index] = format;
+			break;
+		}
+	}
+
+	// Si la table est pleine, la chaîne de format est de nouveau écrite avant chaque message
+	const char *string_format = (const char *) (size_t) format;
+	size_t string_size = strnlen(string_format, LOG_RECORD_MAX_SIZE - sizeof(struct log_record) - sizeof(uint64_t));
+
+	struct log_record header;
+	header.size = (uint32_t) (sizeof(struct log_record) + ((string_size + sizeof(uint64_t)) & ~(sizeof(uint64_t) - 1)));
+	header.type = LOG_RECORD_FORMAT;
+	header.format = format;
+	header.timestamp = 0;
+
+	memset(buffer, 0, header.size);
+	memcpy(buffer, &header, sizeof(header));
+	memcpy(buffer + sizeof(header), string_format, string_size);
+	return header.size;
+}
+
+/**
+ * La fonction log_flush() vide les tampons de tous les threads dans le fichier des logs.
+ * Elle est appelée périodiquement par le thread d'écriture du journal, avant l'écriture d'un message d'erreur
+ * et à la fin du programme.
+ */
+void log_flush() {
+	if (log_flusher.buffer == NULL)
+		return;
+
+	// mutex_lock() et mutex_unlock() ne sont pas utilisées : elles écrivent dans le journal (niveau TRACE)
+	pthread_mutex_lock(&(log_flusher.mutex));
+
+	size_t buffer_size = 0;
+	struct log_ring *log_ring = __atomic_load_n(&(log_flusher.rings), __ATOMIC_ACQUIRE);
+	for (; log_ring != NULL; log_ring = log_ring->next) {
+		size_t dropped_nb = __atomic_load_n(&(log_ring->dropped_nb), __ATOMIC_RELAXED);
+		if (dropped_nb != log_ring->reported_dropped_nb) {
+			if (buffer_size + LOG_RECORD_MAX_SIZE > LOG_FLUSH_BUFFER_SIZE)
+				log_flush_buffer(&buffer_size);
+
+			struct log_record header;
+			header.size = sizeof(struct log_record) + sizeof(uint64_t);
+			header.type = LOG_RECORD_DROPPED;
+			header.format = 0;
+			header.timestamp = get_timestamp();
+
+			uint64_t new_dropped_nb = dropped_nb - log_ring->reported_dropped_nb;
+			memcpy(log_flusher.buffer + buffer_size, &header, sizeof(header));
+			memcpy(log_flusher.buffer + buffer_size + sizeof(header), &new_dropped_nb, sizeof(new_dropped_nb));
+			buffer_size += header.size;
+			log_ring->reported_dropped_nb = dropped_nb;
+		}
+
+		size_t head = __atomic_load_n(&(log_ring->head), __ATOMIC_ACQUIRE);
+		size_t tail = log_ring->tail;
+		while (tail != head) {
+			struct log_record header;
+			log_ring_read(log_ring, tail, &header, sizeof(header));
+
+			// Place pour l'enregistrement et pour la définition de sa chaîne de format
+			if (buffer_size + 2 * LOG_RECORD_MAX_SIZE > LOG_FLUSH_BUFFER_SIZE)
+				log_flush_buffer(&buffer_size);
+
+			if (header.type == LOG_RECORD_MESSAGE)
+				buffer_size += log_format_record(log_flusher.buffer + buffer_size, header.format);
+			log_ring_read(log_ring, tail, log_flusher.buffer + buffer_size, header.size);
+			buffer_size += header.size;
+			tail += header.size;
+		}
+		__atomic_store_n(&(log_ring->tail), tail, __ATOMIC_RELEASE);
+	}
+
+	log_flush_buffer(&buffer_size);
+	pthread_mutex_unlock(&(log_flusher.mutex));
+}
+
+/**
+ * La fonction log_flush_buffer() écrit les buffer_size premiers octets de log_flusher.buffer dans le fichier des logs.
+ * Les erreurs sont ignorées : handle_error() écrirait dans le journal, dont le verrou est détenu.
+ */
+void log_flush_buffer(size_t *buffer_size) {
+	if (*buffer_size == 0)
+		return;
+
+	struct flock logs_file_lock;
+	logs_file_lock.l_type = F_WRLCK;
+	logs_file_lock.l_whence = SEEK_SET;
+	logs_file_lock.l_start = 0;
+	logs_file_lock.l_len = 0;
+
+	// int fcntl(int fd, int cmd, ... /* arg */ );
+	fcntl(logs_file_descriptor, F_SETLKW, &logs_file_lock);
+	// ssize_t write (int fd, const void *buffer, size_t size)
+	write(logs_file_descriptor, log_flusher.buffer, *buffer_size);
+
+	logs_file_lock.l_type = F_UNLCK;
+	fcntl(logs_file_descriptor, F_SETLKW, &logs_file_lock);
+
+	*buffer_size = 0;
+}
+
+void *flush_logs(void *arg) {
+	(void) arg;
+
+	while (1) {
+		// int usleep(useconds_t usec);
+		usleep(LOG_FLUSH_INTERVAL_MS * 1000);
+		log_flush();
+	}
+
+	return NULL;
+}
+
+/**
+ * La fonction get_delta_size() renvoie le nombre de pages qu'il faut ajouter à la mémoire afin de stocker
+ * additional_memory_size octets supplémentaires. Ce calcul permet d'augmenter la mémoire en utilisant
+ * une quantité qui est un multiple de la taille d'une page (taille alignée sur l'adresse d'une page).
+ */
+size_t get_delta_size(size_t additional_memory_size) {
+	// Si le reste de la division additional_memory_size / PAGE_SIZE est supérieur à zéro,
+	// cela signifie qu'une page supplémentaire doit être ajoutée
+	// Exemple (avec la console de Python) : (4097 % 4096) = 1, ((4097)//4096 + (4097) % 4096) = 2
+	size_t number_of_pages = ((additional_memory_size / page_size) + ((additional_memory_size % page_size != 0) ? 1 : 0));
+	size_t delta_size =  number_of_pages * page_size;
+
+	return delta_size;
+}
+
+/**
+ * La fonction get_data_pool_commit_size() renvoie le nombre d'octets d'un pool de data qu'il faut rendre accessibles
+ * afin d'en utiliser needed_size : avec des pages de grande taille, needed_size est arrondi au multiple supérieur
+ * de HUGE_PAGE_SIZE, afin que le noyau n'ait jamais à soutenir une page de grande taille partiellement accessible.
+ */
+size_t get_data_pool_commit_size(size_t needed_size) {
+	if (!huge_pages_enabled)
+		return needed_size;
+
+	return (needed_size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+
+/* ****************************************************************** */
+/* ********* CRÉATION ET ÉLARGISSEMENT DE MAPPAGE DE MÉMOIRE ******** */
+/* ****************************************************************** */
+
+void	*map_memeory(void *address, size_t size) {
+	// void *mmap(void addr, size_t length, int prot, int flags, int fd, off_t offset);
+	// mmap() crée un nouveau mappage dans l'espace d'adressage virtuel du processus appelant.
+	// L'adresse du nouveau mappage est renvoyée à la suite de l'appel.
+	// En cas d'erreur, la valeur MAP_FAILED est renvoyée
+
+	// MAP_ANON : synonyme de MAP_ANONYMOUS ; fourni pour la compatibilité avec d’autres implémentations.
+	// MAP_ANONYMOUS : Le mappage n'est soutenu par aucun fichier ; son contenu est initialisé à zéro.
+	//            	   L'argument fd est ignoré ; cependant, certaines implémentations exigent que fd soit -1
+	//                 si MAP_ANONYMOUS (ou MAP_ANON) est spécifié. L'argument offset doit être nul.
+
+	// MAP_PRIVATE : Créer un mappage copy-on-write privé.
+	//               Les mises à jour du mappage ne sont pas visibles par les autres processus
+	// PROT_READ : les pages peuvent être lues ; PROT_WRITE : les pages peuvent être écrites.
+
+	// Source : Linux manual page
+	void *mmap_result = mmap(address, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	if (mmap_result == MAP_FAILED) {
+		handle_error("Echec de la fonction mmap()");
+	}
+
+	return mmap_result;
+}
+
+/**
+ * La fonction reserve_memeory() réserve size octets d'espace d'adressage virtuel sans les rendre accessibles
+ * (PROT_NONE) : aucune mémoire n'est utilisée tant qu'ils ne sont pas engagés avec commit_memeory().
+ */
+void	*reserve_memeory(size_t size) {
+	// PROT_NONE : les pages ne peuvent pas être accédées.
+	// MAP_NORESERVE : ne pas réserver d'espace de swap pour ce mappage.
+	void *mmap_result = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANON | MAP_NORESERVE, -1, 0);
+	if (mmap_result == MAP_FAILED) {
+		handle_error("Echec de la fonction mmap()");
+	}
+
+	return mmap_result;
+}
+
+/**
+ * La fonction reserve_memeory_aligned() réserve, comme reserve_memeory(), size octets d'espace d'adressage virtuel
+ * dont l'adresse de début est un multiple de alignment (une puissance de 2 multiple de la taille d'une page) :
+ * size + alignment octets sont réservés, puis les octets qui précèdent et qui suivent la zone alignée sont rendus.
+ */
+void	*reserve_memeory_aligned(size_t size, size_t alignment) {
+	size_t reserved = (size_t) reserve_memeory(size + alignment);
+	size_t aligned = (reserved + alignment - 1) & ~(alignment - 1);
+
+	if (aligned > reserved && munmap((void*) reserved, aligned - reserved) != 0)
+		handle_error("Echec de la fonction munmap()");
+
+	if (reserved + alignment > aligned && munmap((void*) (aligned + size), reserved + alignment - aligned) != 0)
+		handle_error("Echec de la fonction munmap()");
+
+	return (void*) aligned;
+}
+
+/**
+ * La fonction commit_memeory() rend accessibles en lecture et en écriture au moins les needed_size premiers octets
+ * de la zone réservée memeory, dont les committed_size premiers octets sont déjà accessibles, et renvoie le nouveau
+ * nombre d'octets accessibles. Afin que les appels à mprotect() restent rares, la partie accessible est au moins
+ * doublée à chaque élargissement (sans dépasser les reserved_size octets de la zone réservée).
+ */
+size_t	commit_memeory(void *memeory, size_t committed_size, size_t needed_size, size_t reserved_size) {
+	if (needed_size <= committed_size)
+		return committed_size;
+
+	if (needed_size > reserved_size)
+		handle_error("L'espace d'adressage reserve pour le pool est epuise");
+
+	size_t new_committed_size = (committed_size * 2 > needed_size) ? committed_size * 2 : get_delta_size(needed_size);
+	if (new_committed_size > reserved_size)
+		new_committed_size = reserved_size;
+
+	// int mprotect(void *addr, size_t len, int prot);
+	// mprotect() modifie les protections d'accès aux pages du processus appelant contenant
+	// une partie quelconque de la plage d'adresses dans l'intervalle [addr, addr+len-1].
+	if (mprotect((void*) ((size_t) memeory + committed_size), new_committed_size - committed_size, PROT_READ | PROT_WRITE) != 0)
+		handle_error("Echec de la fonction mprotect()");
+
+	LOG("%lu octets de la zone reservee %p sont maintenant accessibles \n", new_committed_size, memeory);
+	return new_committed_size;
+}
+
+/**
+ * La fonction decommit_memeory() rend au système les pages d'une zone réservée situées entre new_committed_size
+ * (multiple de la taille d'une page) et committed_size, qui redeviennent inaccessibles. Elle renvoie new_committed_size.
+ */
+size_t	decommit_memeory(void *memeory, size_t committed_size, size_t new_committed_size) {
+	if (new_committed_size >= committed_size)
+		return committed_size;
+
+	void *first_page = (void*) ((size_t) memeory + new_committed_size);
+
+	// int madvise(void *addr, size_t length, int advice);
+	// MADV_DONTNEED : les pages d'un mappage anonyme privé sont libérées, et seront initialisées à zéro
+	// lors du prochain accès
+	if (madvise(first_page, committed_size - new_committed_size, MADV_DONTNEED) != 0)
+		handle_error("Echec de la fonction madvise()");
+
+	if (mprotect(first_page, committed_size - new_committed_size, PROT_NONE) != 0)
+		handle_error("Echec de la fonction mprotect()");
+
+	LOG("%lu octets de la zone reservee %p (a partir de %p) ont ete rendus au systeme et sont maintenant inaccessibles ; %lu octets restent accessibles \n",
+			committed_size - new_committed_size, memeory, first_page, new_committed_size);
+	return new_committed_size;
+}
+
+void exit_handler() {
+	for (size_t i = 0; i < arenas_nb; i++) {
+		struct arena *arena = &arenas[i];
+		if (!arena->initialized)
+			continue;
+
+		// Le pool est parcouru comme un tableau afin d'atteindre aussi les grandes allocations (hors de la liste chaînée)
+		metadata_array_map(arena, 0, clean_data, NULL, 0, 0);
+		int munmap_result;
+
+		if (arena->data_pool != NULL) {
+			// int munmap(void *addr, size_t len);
+			munmap_result = munmap(arena->data_pool, DATA_POOL_RESERVED_SIZE);
+			if (munmap_result != 0)
+				handle_error("Echec de la fonction munmap()");
+
+			arena->data_pool = NULL;
+		}
+
+		if (arena->meta_information_pool_root != NULL) {
+			munmap_result = munmap(arena->meta_information_pool_root, META_INFORMATION_POOL_RESERVED_SIZE);
+			if (munmap_result != 0)
+				handle_error("Echec de la fonction munmap()");
+
+			arena->meta_information_pool_root = NULL;
+		}
+
+		if (arena->unused_bitmap != NULL) {
+			munmap_result = munmap(arena->unused_bitmap, UNUSED_BITMAP_RESERVED_SIZE);
+			if (munmap_result != 0)
+				handle_error("Echec de la fonction munmap()");
+
+			arena->unused_bitmap = NULL;
+		}
+	}
+}
+
+/* ****************************************************************** */
+/* ************************ INITIALISATION ************************** */
+/* ****************************************************************** */
+
+void init() {
+	TRACE("init() \n");
+
+	if (arenas_nb == 0) {
+		init_logs_file_descriptor();
+		init_page_size();
+		init_pointer_index();
+		init_thread_cache();
+		init_stats();
+		init_mmap_threshold();
+		init_huge_pages();
+		init_slabs();
+		init_guard_pool();
+		init_overflow_scan();
+		init_deferred_wipe();
+		init_arenas();
+
+		// L'arène principale est initialisée immédiatement
+		init_arena(&arenas[0]);
+
+		dynamic_overflow_detection_activated = 0;
+		mutex_init(&dynamic_overflow_detection_activated_mutex, 0);
+	}
+}
+
+void init_arenas() {
+	// Par défaut, une arène par processeur disponible
+	long processors_nb = sysconf(_SC_NPROCESSORS_ONLN);
+	arenas_nb = (processors_nb > 0) ? (size_t) processors_nb : 1;
+
+	const char *arenas_nb_str = getenv("MSM_ARENAS");
+	if (arenas_nb_str != NULL && strtoul(arenas_nb_str, NULL, 10) > 0)
+		arenas_nb = strtoul(arenas_nb_str, NULL, 10);
+
+	if (arenas_nb > ARENAS_MAX_NB)
+		arenas_nb = ARENAS_MAX_NB;
+
+	for (size_t i = 0; i < ARENAS_MAX_NB; i++) {
+		arenas[i].index = i;
+		arenas[i].initialized = 0;
+		mutex_init(&(arenas[i].mutex), 0);
+		mutex_init(&(arenas[i].meta_information_pool_mutex), 0);
+
+		for (size_t j = 0; j < SLAB_CLASSES_NB; j++) {
+			arenas[i].slab_classes[j].partial_slabs = NULL;
+			mutex_init(&(arenas[i].slab_classes[j].mutex), 0);
+		}
+	}
+}
+
+void init_arena(struct arena *arena) {
+	if (__atomic_load_n(&(arena->initialized), __ATOMIC_ACQUIRE))
+		return;
+
+	mutex_lock(&(arena->mutex));
+	if (!arena->initialized) {
+		init_free_lists(arena);
+
+		init_data_pool(arena);
+		init_meta_information_pool(arena);
+
+		if (arena->data_pool == NULL || arena->meta_information_pool_root == NULL)
+			handle_error("Echec de l'initialisation de la memoire");
+
+		LOG("Initialisation de l'arene %lu \n", arena->index);
+		__atomic_store_n(&(arena->initialized), 1, __ATOMIC_RELEASE);
+	}
+	mutex_unlock(&(arena->mutex));
 }
 
 
 void pthread_init_once() {
-	DEBUG("pthread_init_once() \n");
+	TRACE("pthread_init_once() \n");
 
 	// int pthread_once(pthread_once_t *once_control, void (*init_routine)(void));
 	int pthread_once_result = pthread_once(&already_initialized, init);
@@ -447,6 +1595,24 @@ void pthread_init_once() {
 
 			LOG("Activation du détecteur dynamique de l'overflow via un thread de parcours du tas \n");
 
+			if (deferred_wipe_min_size != 0) {
+				pthread_create_result = pthread_create(&thread_id, NULL, deferred_wipe, NULL);
+				if (pthread_create_result != 0)
+					handle_errnum("pthread_create()", pthread_create_result);
+
+				LOG("Activation du nettoyage differe des blocs liberes d'au moins %lu octets \n", deferred_wipe_min_size);
+			}
+
+			if (log_flusher.buffer != NULL) {
+				pthread_create_result = pthread_create(&thread_id, NULL, flush_logs, NULL);
+				if (pthread_create_result != 0)
+					handle_errnum("pthread_create()", pthread_create_result);
+
+				// Les messages encore dans les tampons sont écrits à la fin du programme
+				if (atexit(log_flush) != 0)
+					handle_error("Echec de la fonction atexit()");
+			}
+
 			// int atexit(void (*function)(void));
 			// int atexit_result = atexit(exit_handler);
 			// if (atexit_result != 0)
@@ -458,91 +1624,140 @@ void pthread_init_once() {
 	}
 }
 
-struct struct_canary *init_data_pool() {
-	if (data_pool == NULL && meta_information_pool_root == NULL) {
-		data_pool_size = page_size;
-		data_pool = (struct struct_canary *) init_memeory(data_pool, (void*) (page_size * 1500000));
-		LOG("Initialisation du pool de data. L'adresse de debut de ce pool est %p \n", data_pool);
+// Chaque pool est une zone d'espace d'adressage réservée dont seule la partie utilisée est accessible :
+// les pools sont élargis sans jamais être déplacés.
+struct struct_canary *init_data_pool(struct arena *arena) {
+	if (arena->data_pool == NULL && arena->meta_information_pool_root == NULL) {
+		arena->data_pool_size = page_size;
+
+		if (huge_pages_enabled) {
+			arena->data_pool = (struct struct_canary *) reserve_memeory_aligned(DATA_POOL_RESERVED_SIZE, HUGE_PAGE_SIZE);
 
-		struct struct_canary *ptr_end = (struct struct_canary *) ((size_t) data_pool + (page_size - sizeof(struct struct_canary)));
+			// MADV_HUGEPAGE : le noyau peut soutenir la zone par des pages transparentes de grande taille
+			// (échoue si le noyau ne les prend pas en charge : le pool est alors soutenu par des pages ordinaires)
+			if (madvise(arena->data_pool, DATA_POOL_RESERVED_SIZE, MADV_HUGEPAGE) != 0) {
+				LOG_ERROR("Echec de la fonction madvise(MADV_HUGEPAGE) pour le pool de data de l'arene %lu \n", arena->index);
+			}
+		} else {
+			arena->data_pool = (struct struct_canary *) reserve_memeory(DATA_POOL_RESERVED_SIZE);
+		}
+
+		arena->data_pool_committed_size = commit_memeory(arena->data_pool, 0, get_data_pool_commit_size(page_size), DATA_POOL_RESERVED_SIZE);
+		LOG("Initialisation du pool de data de l'arene %lu. L'adresse de debut de ce pool est %p \n", arena->index, arena->data_pool);
+
+		struct struct_canary *ptr_end = (struct struct_canary *) ((size_t) arena->data_pool + (page_size - sizeof(struct struct_canary)));
 		ptr_end->canary = get_canary();
 	}
 
-	return data_pool;
+	return arena->data_pool;
 }
 
-struct meta_information *init_meta_information_pool() {
-	if (meta_information_pool_root == NULL && data_pool != NULL) {
-		meta_information_pool_size = page_size;
-		meta_information_pool_root = (struct meta_information *) init_memeory(meta_information_pool_root, (void*) page_size);
-		LOG("Initialisation du pool de meta-information. L'adresse de debut de ce pool est %p \n", meta_information_pool_root);
+struct meta_information *init_meta_information_pool(struct arena *arena) {
+	if (arena->meta_information_pool_root == NULL && arena->data_pool != NULL) {
+		arena->meta_information_pool_size = page_size;
+		arena->meta_information_pool_root = (struct meta_information *) reserve_memeory(META_INFORMATION_POOL_RESERVED_SIZE);
+		arena->meta_information_pool_committed_size = commit_memeory(arena->meta_information_pool_root, 0, page_size, META_INFORMATION_POOL_RESERVED_SIZE);
+		LOG("Initialisation du pool de meta-information de l'arene %lu. L'adresse de debut de ce pool est %p \n", arena->index, arena->meta_information_pool_root);
 
-		// Pour initialiser la première structure de données
-		meta_information_pool_root->data_ptr = data_pool;
-		meta_information_pool_root->size = page_size - sizeof(struct struct_canary);
-		meta_information_pool_root->status = FREE;
+		metadata_array_map(arena, 0, init_empty_meta_information_struct, arena, 0, 1);
 
-		meta_information_pool_root->prev = NULL;
-		meta_information_pool_root->next = NULL;
+		// Tous les blocs de métadonnées, sauf le premier, sont inutilisés
+		unused_bitmap_extend(arena, 1, arena->meta_information_pool_size / sizeof(struct meta_information));
 
-		mutex_init(&(meta_information_pool_root->mutex), 1);
-		metadata_array_map(meta_information_pool_root, 0, init_empty_meta_information_struct, NULL, 1, 1);
+		// Pour initialiser la première structure de données
+		struct meta_information *root = arena->meta_information_pool_root;
+		root->data_ptr = arena->data_pool;
+		root->size = page_size - sizeof(struct struct_canary);
+		root->status = FREE;
+		root->zeroed = 1;
+		arena->meta_information_pool_last = root;
+
+		// Le premier bloc (qui couvre tout le pool de data) est libre
+		free_list_insert(root);
 	}
 
-	return meta_information_pool_root;
+	return arena->meta_information_pool_root;
 }
 
 /* ****************************************************************** */
 /* ***************** EXTENSION DES ZONES MÉMOIRE ******************** */
 /* ****************************************************************** */
 
-void extend_meta_information_pool() {
-	struct meta_information *new_meta_information_pool = (struct meta_information*) remap_memeory(meta_information_pool_root, meta_information_pool_size, page_size);
-	if (new_meta_information_pool != meta_information_pool_root) {
-		LOG("Le pool de meta-information a change d'adresse apres un redimensionnement. "
-				"La nouvelle adresse est %p \n", new_meta_information_pool);
-		meta_information_pool_root = new_meta_information_pool;
-	}
+/**
+ * La fonction extend_meta_information_pool() élargit le pool de meta-information de l'arène arena d'une page.
+ * Les nouveaux blocs de métadonnées sont ajoutés à la bitmap des blocs inutilisés.
+ * Le verrou meta_information_pool_mutex de l'arène doit être détenu par l'appelant.
+ */
+void extend_meta_information_pool(struct arena *arena) {
+	arena->meta_information_pool_committed_size = commit_memeory(arena->meta_information_pool_root, arena->meta_information_pool_committed_size,
+			arena->meta_information_pool_size + page_size, META_INFORMATION_POOL_RESERVED_SIZE);
 
-	size_t meta_information_pool_elements_nb_before = meta_information_pool_size / sizeof(struct meta_information);
-	meta_information_pool_size += page_size;
-	LOG("Le pool de meta-informations a ete elargi. La nouvelle taille est %lu. \n", meta_information_pool_size);
+	size_t meta_information_pool_elements_nb_before = arena->meta_information_pool_size / sizeof(struct meta_information);
+	arena->meta_information_pool_size += page_size;
+	LOG("Le pool de meta-informations a ete elargi. La nouvelle taille est %lu. \n", arena->meta_information_pool_size);
 
-	metadata_array_map(meta_information_pool_root, 0, init_empty_meta_information_struct, NULL, meta_information_pool_elements_nb_before, 1);
+	metadata_array_map(arena, 0, init_empty_meta_information_struct, arena, meta_information_pool_elements_nb_before, 1);
+	unused_bitmap_extend(arena, meta_information_pool_elements_nb_before, arena->meta_information_pool_size / sizeof(struct meta_information));
 }
 
-void extend_data_pool(struct meta_information* last_meta_information_item, size_t data_pool_delta_size, size_t last_meta_information_item_new_size_including_canary) {
-	struct struct_canary* new_data_pool = remap_memeory(data_pool, data_pool_size, data_pool_delta_size);
-	if (new_data_pool != data_pool) {
-		LOG("Le pool de data a change d'adresse apres un redimensionnement. "
-				"La nouvelle adresse est %p \n", new_data_pool);
-		data_pool = new_data_pool;
-	}
+/**
+ * La fonction extend_data_pool() élargit de data_pool_delta_size octets le pool de data de l'arène du dernier bloc
+ * last_meta_information_item (dont le verrou est détenu par l'appelant). Le dernier bloc s'étend jusqu'à la nouvelle
+ * fin du pool : son canari occupe les derniers octets du pool.
+ */
+void extend_data_pool(struct meta_information* last_meta_information_item, size_t data_pool_delta_size) {
+	struct arena *arena = last_meta_information_item->arena;
+
+	// Le dernier bloc est verrouillé par l'appelant : un seul thread à la fois élargit le pool de data d'une arène
+	arena->data_pool_committed_size = commit_memeory(arena->data_pool, arena->data_pool_committed_size,
+			get_data_pool_commit_size(arena->data_pool_size + data_pool_delta_size), DATA_POOL_RESERVED_SIZE);
 
 	if (last_meta_information_item->data_ptr == NULL && last_meta_information_item->status == UNUSED) {
+		// La partie du pool de data qui suit sa fin n'a jamais été utilisée : elle ne contient que des zéros
 		last_meta_information_item->status = FREE;
-		last_meta_information_item->data_ptr = (struct struct_canary *) ((size_t) data_pool + data_pool_size);
+		last_meta_information_item->zeroed = 1;
+		last_meta_information_item->data_ptr = (struct struct_canary *) ((size_t) arena->data_pool + arena->data_pool_size);
+	} else {
+		// L'ancien canari du dernier bloc fait désormais partie de son bloc de données
+		memset((void*) ((size_t) last_meta_information_item->data_ptr + last_meta_information_item->size), 0, sizeof(struct struct_canary));
 	}
 
-	data_pool_size += data_pool_delta_size;
-	LOG("Le pool de data a ete elargi. La nouvelle taille est %lu\n", data_pool_size);
+	arena->data_pool_size += data_pool_delta_size;
+	LOG("Le pool de data a ete elargi. La nouvelle taille est %lu\n", arena->data_pool_size);
 
 	// Mettre à jour les informations concernant le dernier morceau
-	last_meta_information_item->size = last_meta_information_item_new_size_including_canary - sizeof(struct struct_canary);
+	last_meta_information_item->size = ((size_t) arena->data_pool + arena->data_pool_size) - (size_t) last_meta_information_item->data_ptr
+			- sizeof(struct struct_canary);
 
 	struct struct_canary *ptr_end = (struct struct_canary *) ((size_t) last_meta_information_item->data_ptr + last_meta_information_item->size);
 	ptr_end->canary = get_canary();
-	LOG("La nouvelle taille du dernier bloc de metadonnees (%p) : %lu\n", last_meta_information_item, last_meta_information_item->size);
+	DEBUG("La nouvelle taille du dernier bloc de metadonnees (%p) : %lu\n", last_meta_information_item, last_meta_information_item->size);
 }
 
 /* ************************************************************************************************ */
 /* * FONCTIONS POUVANT ÊTRE PASSÉES EN PARAMÈTRE À METADATA_LINKED_LIST_MAP OU METADATA_ARRAY_MAP * */
 /* *********************************************************************************************** */
 
+/**
+ * La fonction clean_data() nettoie le bloc de données d'un bloc de métadonnées (dont le verrou est détenu par l'appelant)
+ * qui est occupé ou conservé dans le cache d'un thread, et rend au système le mappage d'une grande allocation.
+ */
 int clean_data(struct meta_information *meta_information_element, void *arg2) {
 	(void) arg2;
-	if (meta_information_element != NULL && meta_information_element->status == BUSY) {
-		clean(meta_information_element->data_ptr);
+	if (meta_information_element == NULL || meta_information_element->data_ptr == NULL)
+		return 0;
+
+	if (meta_information_element->status == BUSY || meta_information_element->status == CACHED
+			|| meta_information_element->status == GUARDED || meta_information_element->status == WIPING) {
+		// void * memset(void * block, int value, size_t size);
+		memset(meta_information_element->data_ptr, 0, meta_information_element->size);
+	} else if (meta_information_element->status == MAPPED) {
+		pointer_index_remove(meta_information_element->data_ptr);
+		munmap(meta_information_element->data_ptr, get_delta_size(meta_information_element->size + sizeof(struct struct_canary)));
+
+		meta_information_element->data_ptr = NULL;
+		meta_information_element->size = 0;
+		meta_information_element->status = UNUSED;
 	}
 
 	return 0;
@@ -553,8 +1768,21 @@ int overflow_detection(struct meta_information *meta_information_element, void *
 	if (meta_information_element == NULL || meta_information_element->data_ptr == NULL)
 		return 0;
 
+	// Une allocation échantillonnée n'a pas de canari : un overflow atteint la page de garde, sauf s'il reste dans
+	// les octets qui séparent la fin des données de la page de garde (au plus ALLOCATION_ALIGNMENT - 1), qui contiennent un motif
+	if (meta_information_element->status == GUARDED) {
+		size_t data_end = (size_t) meta_information_element->data_ptr + meta_information_element->size;
+		size_t guard_page = (size_t) meta_information_element->data_ptr
+				+ ((meta_information_element->size + ALLOCATION_ALIGNMENT - 1) & ~((size_t) ALLOCATION_ALIGNMENT - 1));
+		for (size_t address = data_end; address < guard_page; address++) {
+			if (*((unsigned char *) address) != get_guard_slack_byte(address))
+				return 1;
+		}
+		return 0;
+	}
+
 	struct struct_canary *chunck = (struct struct_canary *) ((size_t) meta_information_element->data_ptr + meta_information_element->size);
-	DEBUG("canary_position %ld get_canary %ld meta_information_element %p \n", struct_canary->canary, get_canary(), meta_information_element);
+	TRACE("canary_position %ld get_canary %ld meta_information_element %p \n", chunck->canary, get_canary(), meta_information_element);
 
 	return(chunck->canary != get_canary());
 }
@@ -573,17 +1801,24 @@ int is_meta_information_of_free_memory(struct meta_information * meta_informatio
 	return (meta_information_element->status == FREE && meta_information_element->size >= memory_size_value);
 }
 
-int init_empty_meta_information_struct(struct meta_information * meta_information_element, void *arg2) {
-	(void) arg2;
-
+/**
+ * La fonction init_empty_meta_information_struct() initialise un bloc de métadonnées inutilisé
+ * du pool de meta-information de l'arène arena.
+ */
+int init_empty_meta_information_struct(struct meta_information * meta_information_element, void *arena) {
+	meta_information_element->arena = (struct arena *) arena;
 	meta_information_element->size = 0;
 	meta_information_element->data_ptr = NULL;
 	meta_information_element->status = UNUSED;
+	meta_information_element->zeroed = 0;
 
 	meta_information_element->next = NULL;
 	meta_information_element->prev = NULL;
+	meta_information_element->next_free = NULL;
+	meta_information_element->prev_free = NULL;
+	meta_information_element->next_in_index = NULL;
 
-	mutex_init(&(meta_information_element->mutex), 1);
+	spinlock_init(&(meta_information_element->lock));
 	return 0;
 }
 
@@ -593,8 +1828,12 @@ int init_if_empty_meta_information_struct(struct meta_information * meta_informa
 	if (meta_information_element->status == UNUSED) {
 		// Pour s'assurer que toutes les données de la structure sont initialisées
 		meta_information_element->size = 0;
+		meta_information_element->zeroed = 0;
 		meta_information_element->next = NULL;
 		meta_information_element->prev = NULL;
+		meta_information_element->next_free = NULL;
+		meta_information_element->prev_free = NULL;
+		meta_information_element->next_in_index = NULL;
 		meta_information_element->data_ptr = NULL;
 		return 1;
 	}
@@ -602,25 +1841,367 @@ int init_if_empty_meta_information_struct(struct meta_information * meta_informa
 }
 
 
+/* ****************************************************************** */
+/* ********** GESTION DES BLOCS DE MÉTADONNÉES INUTILISÉS *********** */
+/* ****************************************************************** */
+
+// Chaque arène conserve une bitmap des blocs inutilisés de son pool de meta-information.
+// L'obtention d'un bloc inutilisé ne parcourt donc pas le pool bloc par bloc (en essayant de prendre
+// chaque verrou), mais les mots de la bitmap, à partir du premier mot qui peut contenir un bit à 1.
+// Ordre de prise des verrous : le verrou meta_information_pool_mutex est pris après le verrou
+// d'un bloc de métadonnées, et aucun verrou de bloc n'est pris en sa présence.
+
+/**
+ * La fonction unused_bitmap_extend() marque comme inutilisés les blocs de métadonnées d'indice
+ * first_index à last_index - 1 de l'arène arena. Le mappage de la bitmap est élargi si nécessaire.
+ */
+void unused_bitmap_extend(struct arena *arena, size_t first_index, size_t last_index) {
+	size_t bitmap_size = ((last_index + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS) * sizeof(size_t);
+
+	if (arena->unused_bitmap == NULL) {
+		// Le contenu d'un mappage anonyme est initialisé à zéro : aucun bloc n'est marqué
+		arena->unused_bitmap = (size_t *) reserve_memeory(UNUSED_BITMAP_RESERVED_SIZE);
+		arena->unused_bitmap_size = 0;
+		arena->unused_bitmap_hint = 0;
+	}
+
+	arena->unused_bitmap_size = commit_memeory(arena->unused_bitmap, arena->unused_bitmap_size, bitmap_size, UNUSED_BITMAP_RESERVED_SIZE);
+
+	for (size_t i = first_index; i < last_index; i++)
+		arena->unused_bitmap[i / BITMAP_WORD_BITS] |= (size_t) 1 << (i % BITMAP_WORD_BITS);
+
+	if (first_index / BITMAP_WORD_BITS < arena->unused_bitmap_hint)
+		arena->unused_bitmap_hint = first_index / BITMAP_WORD_BITS;
+}
+
+/**
+ * La fonction get_unused_meta_information_struct() renvoie un bloc de métadonnées inutilisé (verrouillé)
+ * du pool de meta-information de l'arène arena. Le pool est élargi s'il ne contient aucun bloc inutilisé.
+ */
+struct meta_information *get_unused_meta_information_struct(struct arena *arena) {
+	mutex_lock(&(arena->meta_information_pool_mutex));
+
+	size_t word_index = arena->unused_bitmap_hint;
+	while (1) {
+		size_t words_nb = (arena->meta_information_pool_size / sizeof(struct meta_information) + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS;
+		while (word_index < words_nb && arena->unused_bitmap[word_index] == 0)
+			word_index++;
+
+		if (word_index < words_nb)
+			break;
+
+		extend_meta_information_pool(arena);
+		word_index = arena->unused_bitmap_hint;
+	}
+
+	// Le premier bit à 1 du mot (find first set)
+	size_t bit_index = __builtin_ctzl(arena->unused_bitmap[word_index]);
+	arena->unused_bitmap[word_index] &= ~((size_t) 1 << bit_index);
+	arena->unused_bitmap_hint = word_index;
+
+	struct meta_information *meta_information_element = &(arena->meta_information_pool_root[word_index * BITMAP_WORD_BITS + bit_index]);
+	mutex_unlock(&(arena->meta_information_pool_mutex));
+
+	// Le verrou d'un bloc inutilisé peut encore être détenu, brièvement, par le thread qui vient de le rendre
+	spinlock_lock(&(meta_information_element->lock));
+	init_if_empty_meta_information_struct(meta_information_element, NULL);
+	return meta_information_element;
+}
+
+/**
+ * La fonction put_unused_meta_information_struct() rend à la bitmap de son arène un bloc de métadonnées
+ * dont le statut est UNUSED et dont le verrou a été relâché par l'appelant.
+ */
+void put_unused_meta_information_struct(struct meta_information *meta_information_element) {
+	struct arena *arena = meta_information_element->arena;
+
+	mutex_lock(&(arena->meta_information_pool_mutex));
+	size_t index = (size_t) (meta_information_element - arena->meta_information_pool_root);
+	arena->unused_bitmap[index / BITMAP_WORD_BITS] |= (size_t) 1 << (index % BITMAP_WORD_BITS);
+
+	if (index / BITMAP_WORD_BITS < arena->unused_bitmap_hint)
+		arena->unused_bitmap_hint = index / BITMAP_WORD_BITS;
+	mutex_unlock(&(arena->meta_information_pool_mutex));
+}
+
+/* ****************************************************************** */
+/* **************** GESTION DES LISTES DE BLOCS LIBRES ************** */
+/* ****************************************************************** */
+
+// Chaque bloc libre appartient à la liste de blocs libres de sa classe de taille.
+// La recherche d'un bloc libre se fait ainsi sans parcourir les blocs occupés.
+// Ordre de prise des verrous : le verrou d'un bloc de métadonnées est toujours pris avant
+// le verrou d'une liste de blocs libres. Lorsque le verrou d'une liste est déjà détenu,
+// seul spinlock_trylock() est utilisé sur les blocs de métadonnées (voir free_list_take()).
+// Un bloc libre dont le verrou n'est pas détenu se trouve toujours dans sa liste.
+
+void init_free_lists(struct arena *arena) {
+	for (size_t i = 0; i < FREE_LISTS_NB; i++) {
+		arena->free_lists[i].head = NULL;
+		mutex_init(&(arena->free_lists[i].mutex), 0);
+	}
+	arena->free_lists_bitmap = 0;
+}
+
+/**
+ * La fonction get_free_list_index() renvoie l'indice de la liste de blocs libres
+ * correspondant à size, c'est-à-dire la partie entière du logarithme en base 2 de size.
+ */
+size_t get_free_list_index(size_t size) {
+	if (size == 0)
+		return 0;
+
+	// int __builtin_clzl (unsigned long x)
+	// Renvoie le nombre de bits à 0 en tête de x, en commençant par le bit de poids fort.
+	return (FREE_LISTS_NB - 1) - (size_t) __builtin_clzl(size);
+}
+
+/**
+ * La fonction free_list_insert() ajoute un bloc libre en tête de la liste correspondant à sa taille.
+ * Le verrou du bloc doit être détenu par l'appelant.
+ */
+void free_list_insert(struct meta_information *meta_information_element) {
+	struct arena *arena = meta_information_element->arena;
+	size_t index = get_free_list_index(meta_information_element->size);
+	struct free_list *list = &(arena->free_lists[index]);
+
+	mutex_lock(&(list->mutex));
+	meta_information_element->prev_free = NULL;
+	meta_information_element->next_free = list->head;
+	if (list->head != NULL)
+		list->head->prev_free = meta_information_element;
+	list->head = meta_information_element;
+
+	__atomic_fetch_or(&(arena->free_lists_bitmap), (size_t) 1 << index, __ATOMIC_RELEASE);
+	mutex_unlock(&(list->mutex));
+}
+
+/**
+ * La fonction free_list_remove() retire un bloc libre de la liste correspondant à sa taille.
+ * Le verrou du bloc doit être détenu par l'appelant, et la taille du bloc ne doit pas avoir été
+ * modifiée depuis son insertion dans la liste.
+ */
+void free_list_remove(struct meta_information *meta_information_element) {
+	size_t index = get_free_list_index(meta_information_element->size);
+	struct free_list *list = &(meta_information_element->arena->free_lists[index]);
+
+	mutex_lock(&(list->mutex));
+	free_list_unlink(index, meta_information_element);
+	mutex_unlock(&(list->mutex));
+}
+
+/**
+ * La fonction free_list_unlink() détache un bloc de la liste de blocs libres d'indice index.
+ * Le verrou de la liste doit être détenu par l'appelant.
+ */
+void free_list_unlink(size_t index, struct meta_information *meta_information_element) {
+	struct arena *arena = meta_information_element->arena;
+	struct free_list *list = &(arena->free_lists[index]);
+
+	if (meta_information_element->prev_free != NULL)
+		meta_information_element->prev_free->next_free = meta_information_element->next_free;
+	else
+		list->head = meta_information_element->next_free;
+
+	if (meta_information_element->next_free != NULL)
+		meta_information_element->next_free->prev_free = meta_information_element->prev_free;
+
+	meta_information_element->prev_free = NULL;
+	meta_information_element->next_free = NULL;
+
+	if (list->head == NULL)
+		__atomic_fetch_and(&(arena->free_lists_bitmap), ~((size_t) 1 << index), __ATOMIC_RELEASE);
+}
+
+/**
+ * La fonction free_list_take() retire des listes de blocs libres de l'arène arena un bloc qui peut contenir
+ * au moins size octets et le renvoie verrouillé, ou renvoie NULL si aucun bloc n'a été trouvé.
+ * Seule la liste correspondant à size doit être parcourue : tous les blocs des listes suivantes
+ * sont suffisamment grands.
+ */
+struct meta_information *free_list_take(struct arena *arena, size_t size) {
+	size_t index = get_free_list_index(size);
+
+	while (index < FREE_LISTS_NB) {
+		// Les listes vides sont ignorées sans prendre leur verrou
+		size_t bitmap = __atomic_load_n(&(arena->free_lists_bitmap), __ATOMIC_ACQUIRE) >> index;
+		if (bitmap == 0)
+			break;
+
+		// int __builtin_ctzl (unsigned long x)
+		// Renvoie le nombre de bits à 0 en queue de x, en commençant par le bit de poids faible.
+		index += (size_t) __builtin_ctzl(bitmap);
+
+		struct free_list *list = &(arena->free_lists[index]);
+		mutex_lock(&(list->mutex));
+
+		for (struct meta_information *element = list->head; element != NULL; element = element->next_free) {
+			if (element->size >= size && spinlock_trylock(&(element->lock))) {
+				// Le bloc est retiré de la liste pendant que son verrou et celui de la liste sont détenus
+				free_list_unlink(index, element);
+				mutex_unlock(&(list->mutex));
+				return element;
+			}
+		}
+
+		mutex_unlock(&(list->mutex));
+		index++;
+	}
+
+	return NULL;
+}
+
+/* ****************************************************************** */
+/* ********************** INDEX DES POINTEURS *********************** */
+/* ****************************************************************** */
+
+// L'index des pointeurs permet de retrouver le bloc de métadonnées d'un bloc occupé à partir de son adresse
+// sans parcourir la liste chaînée. Les blocs de métadonnées sont chaînés entre eux dans chaque case
+// de la table (next_in_index), la table ne contient donc que des pointeurs.
+// Ordre de prise des verrous : le verrou d'un bloc de métadonnées est toujours pris avant un verrou de l'index.
+
+void init_pointer_index() {
+	pointer_index.buckets_nb = page_size / sizeof(struct meta_information *);
+	if (pointer_index.buckets_nb < POINTER_INDEX_MUTEXES_NB)
+		pointer_index.buckets_nb = POINTER_INDEX_MUTEXES_NB;
+
+	// Le contenu d'un mappage anonyme est initialisé à zéro : toutes les cases sont vides
+	pointer_index.buckets = (struct meta_information **) map_memeory(NULL, pointer_index.buckets_nb * sizeof(struct meta_information *));
+	pointer_index.elements_nb = 0;
+
+	for (size_t i = 0; i < POINTER_INDEX_MUTEXES_NB; i++)
+		mutex_init(&(pointer_index.mutexes[i]), 0);
+}
+
+size_t get_pointer_index_hash(void *memory_ptr) {
+	// Hachage multiplicatif (constante de Knuth), les bits de poids fort étant ramenés vers les bits de poids faible
+	size_t hash = (size_t) memory_ptr * 0x9E3779B97F4A7C15UL;
+	return hash ^ (hash >> 32);
+}
+
+void pointer_index_insert(struct meta_information *meta_information_element) {
+	size_t hash = get_pointer_index_hash(meta_information_element->data_ptr);
+	pthread_mutex_t *mutex = &(pointer_index.mutexes[hash % POINTER_INDEX_MUTEXES_NB]);
+
+	mutex_lock(mutex);
+	struct meta_information **bucket = &(pointer_index.buckets[hash & (pointer_index.buckets_nb - 1)]);
+	meta_information_element->next_in_index = *bucket;
+	*bucket = meta_information_element;
+	size_t elements_nb = __atomic_add_fetch(&(pointer_index.elements_nb), 1, __ATOMIC_RELAXED);
+	size_t buckets_nb = pointer_index.buckets_nb;
+	mutex_unlock(mutex);
+
+	// L'agrandissement nécessite tous les verrous de l'index : il se fait après avoir relâché le verrou de la case
+	if (elements_nb > buckets_nb * POINTER_INDEX_MAX_LOAD)
+		pointer_index_grow();
+}
+
+/**
+ * La fonction pointer_index_remove() retire de l'index le bloc de métadonnées du bloc occupé
+ * commençant à l'adresse memory_ptr et le renvoie (non verrouillé), ou renvoie NULL si memory_ptr
+ * n'est pas l'adresse d'un bloc occupé.
+ */
+struct meta_information *pointer_index_remove(void *memory_ptr) {
+	size_t hash = get_pointer_index_hash(memory_ptr);
+	pthread_mutex_t *mutex = &(pointer_index.mutexes[hash % POINTER_INDEX_MUTEXES_NB]);
+
+	mutex_lock(mutex);
+	struct meta_information **element_ptr = &(pointer_index.buckets[hash & (pointer_index.buckets_nb - 1)]);
+	while (*element_ptr != NULL && (*element_ptr)->data_ptr != memory_ptr)
+		element_ptr = &((*element_ptr)->next_in_index);
+
+	struct meta_information *meta_information_element = *element_ptr;
+	if (meta_information_element != NULL) {
+		*element_ptr = meta_information_element->next_in_index;
+		meta_information_element->next_in_index = NULL;
+		__atomic_sub_fetch(&(pointer_index.elements_nb), 1, __ATOMIC_RELAXED);
+	}
+	mutex_unlock(mutex);
+
+	return meta_information_element;
+}
+
+/**
+ * La fonction pointer_index_find() renvoie le bloc de métadonnées (non verrouillé) du bloc occupé
+ * commençant à l'adresse memory_ptr, ou NULL si memory_ptr n'est pas l'adresse d'un bloc occupé.
+ */
+struct meta_information *pointer_index_find(void *memory_ptr) {
+	size_t hash = get_pointer_index_hash(memory_ptr);
+	pthread_mutex_t *mutex = &(pointer_index.mutexes[hash % POINTER_INDEX_MUTEXES_NB]);
+
+	mutex_lock(mutex);
+	struct meta_information *meta_information_element = pointer_index.buckets[hash & (pointer_index.buckets_nb - 1)];
+	while (meta_information_element != NULL && meta_information_element->data_ptr != memory_ptr)
+		meta_information_element = meta_information_element->next_in_index;
+	mutex_unlock(mutex);
+
+	return meta_information_element;
+}
+
+void pointer_index_grow() {
+	for (size_t i = 0; i < POINTER_INDEX_MUTEXES_NB; i++)
+		mutex_lock(&(pointer_index.mutexes[i]));
+
+	// Un autre thread a pu agrandir la table entre-temps
+	if (pointer_index.elements_nb > pointer_index.buckets_nb * POINTER_INDEX_MAX_LOAD) {
+		size_t new_buckets_nb = pointer_index.buckets_nb * 2;
+		struct meta_information **new_buckets = (struct meta_information **) map_memeory(NULL, new_buckets_nb * sizeof(struct meta_information *));
+
+		for (size_t i = 0; i < pointer_index.buckets_nb; i++) {
+			struct meta_information *meta_information_element = pointer_index.buckets[i];
+			while (meta_information_element != NULL) {
+				struct meta_information *next_in_index = meta_information_element->next_in_index;
+				size_t new_bucket = get_pointer_index_hash(meta_information_element->data_ptr) & (new_buckets_nb - 1);
+
+				meta_information_element->next_in_index = new_buckets[new_bucket];
+				new_buckets[new_bucket] = meta_information_element;
+				meta_information_element = next_in_index;
+			}
+		}
+
+		// int munmap(void *addr, size_t len);
+		if (munmap(pointer_index.buckets, pointer_index.buckets_nb * sizeof(struct meta_information *)) != 0)
+			handle_error("Echec de la fonction munmap()");
+
+		pointer_index.buckets = new_buckets;
+		pointer_index.buckets_nb = new_buckets_nb;
+		LOG("L'index des pointeurs a ete agrandi. Le nouveau nombre de cases est %lu \n", new_buckets_nb);
+	}
+
+	for (size_t i = POINTER_INDEX_MUTEXES_NB; i > 0; i--)
+		mutex_unlock(&(pointer_index.mutexes[i - 1]));
+}
+
 /* ****************************************************************** */
 /* *********** GESTION DE LA LISTE CHAÎNÉE DES MÉTADONNÉES ********** */
 /* ****************************************************************** */
 
 struct meta_information *get_empty_meta_information_struct(struct meta_information *prev_meta_information_struct) {
 	if (prev_meta_information_struct == NULL) {
-		prev_meta_information_struct = metadata_linked_list_map(meta_information_pool_root, 1, is_last_meta_information_struct, NULL, 0);
+		prev_meta_information_struct = metadata_linked_list_map(get_thread_arena()->meta_information_pool_root, 1, is_last_meta_information_struct, NULL, 0);
 	}
 
-	struct meta_information *empty_meta_information_struct = metadata_array_map(meta_information_pool_root, 1, init_if_empty_meta_information_struct, NULL, 0, 0);
-	if (empty_meta_information_struct == NULL) {
-		extend_meta_information_pool();
-		empty_meta_information_struct = metadata_array_map(meta_information_pool_root, 1, init_if_empty_meta_information_struct, NULL, 0, 0);
-	}
+	// Le nouveau bloc de métadonnées appartient à la même arène que le bloc précédent
+	struct arena *arena = prev_meta_information_struct->arena;
 
+	struct meta_information *empty_meta_information_struct = get_unused_meta_information_struct(arena);
+
+	struct meta_information *next_meta_information_struct = prev_meta_information_struct->next;
 	empty_meta_information_struct->prev = prev_meta_information_struct;
-	empty_meta_information_struct->next = prev_meta_information_struct->next;
+	empty_meta_information_struct->next = next_meta_information_struct;
+
+	// Le bloc précédent d'un bloc ne change qu'en présence de son verrou
+	if (next_meta_information_struct != NULL) {
+		spinlock_lock(&(next_meta_information_struct->lock));
+		next_meta_information_struct->prev = empty_meta_information_struct;
+		spinlock_unlock(&(next_meta_information_struct->lock));
+	}
 	prev_meta_information_struct->next = empty_meta_information_struct;
 
+	// Le nouveau bloc est inséré après le dernier bloc : il devient le dernier bloc
+	if (empty_meta_information_struct->next == NULL)
+		arena->meta_information_pool_last = empty_meta_information_struct;
+
 	return empty_meta_information_struct;
 }
 
@@ -630,14 +2211,14 @@ struct meta_information *metadata_linked_list_map(struct meta_information * meta
 		return NULL;
 	}
 
-	mutex_lock(&(meta_information_root->mutex));
+	spinlock_lock(&(meta_information_root->lock));
 
-	DEBUG("metadata_linked_list_map root %p size %lu - status %u data_ptr %p prev %p next %p \n", meta_information_root,
+	TRACE("metadata_linked_list_map root %p size %lu - status %u data_ptr %p prev %p next %p \n", meta_information_root,
 			meta_information_root->size, meta_information_root->status, meta_information_root->data_ptr, meta_information_root->prev, meta_information_root->next);
 
 	if (func(meta_information_root, func_arg2) && return_if_func_true) {
 		if (unlock_mutex_before_return) {
-			mutex_unlock(&(meta_information_root->mutex));
+			spinlock_unlock(&(meta_information_root->lock));
 		}
 
 		return meta_information_root;
@@ -647,54 +2228,56 @@ struct meta_information *metadata_linked_list_map(struct meta_information * meta
 	struct meta_information *curr_element_ptr = prev_element_ptr->next;
 
 	while (curr_element_ptr != NULL) {
-		mutex_lock(&(curr_element_ptr->mutex));
+		spinlock_lock(&(curr_element_ptr->lock));
 
-		DEBUG("metadata_linked_list_map %p size %lu - status %u data_ptr %p prev %p next %p \n", curr_element_ptr,
+		TRACE("metadata_linked_list_map %p size %lu - status %u data_ptr %p prev %p next %p \n", curr_element_ptr,
 				curr_element_ptr->size, curr_element_ptr->status, curr_element_ptr->data_ptr, curr_element_ptr->prev, curr_element_ptr->next);
 
 		if (func(curr_element_ptr, func_arg2) && return_if_func_true) {
 			if (unlock_mutex_before_return) {
-				mutex_unlock(&(curr_element_ptr->mutex));
+				spinlock_unlock(&(curr_element_ptr->lock));
 			}
 
-			mutex_unlock(&(prev_element_ptr->mutex));
+			spinlock_unlock(&(prev_element_ptr->lock));
 			return curr_element_ptr;
 		}
 
-		mutex_unlock(&(prev_element_ptr->mutex));
+		spinlock_unlock(&(prev_element_ptr->lock));
 		prev_element_ptr = curr_element_ptr;
 		curr_element_ptr = curr_element_ptr->next;
 	}
 
-	mutex_unlock(&(prev_element_ptr->mutex));
+	spinlock_unlock(&(prev_element_ptr->lock));
 
-	DEBUG("metadata_linked_list_map : NULL \n");
+	TRACE("metadata_linked_list_map : NULL \n");
 	return NULL;
 }
 
-struct meta_information *metadata_array_map(struct meta_information * meta_information_root, int return_if_func_true,
+struct meta_information *metadata_array_map(struct arena *arena, int return_if_func_true,
 		int (*func) (struct meta_information *, void *), void *func_arg2, size_t start_index, int unlock_mutex_before_return) {
-	for (size_t i = start_index ; i < (meta_information_pool_size / sizeof(struct meta_information)) ; i++) {
-		if (func == init_empty_meta_information_struct || mutex_trylock(&(meta_information_pool_root[i].mutex))) {
+	struct meta_information *meta_information_root = arena->meta_information_pool_root;
+
+	for (size_t i = start_index ; i < (arena->meta_information_pool_size / sizeof(struct meta_information)) ; i++) {
+		if (func == init_empty_meta_information_struct || spinlock_trylock(&(meta_information_root[i].lock))) {
 
-			DEBUG("metadata_array_map %p size %lu - status %u data_ptr %p prev %p next %p \n", &meta_information_pool_root[i],
-					meta_information_pool_root[i].size, meta_information_pool_root[i].status, meta_information_pool_root[i].data_ptr,
-					meta_information_pool_root[i].prev, meta_information_pool_root[i].next);
+			TRACE("metadata_array_map %p size %lu - status %u data_ptr %p prev %p next %p \n", &meta_information_root[i],
+					meta_information_root[i].size, meta_information_root[i].status, meta_information_root[i].data_ptr,
+					meta_information_root[i].prev, meta_information_root[i].next);
 
 			if (func(&meta_information_root[i], func_arg2) && return_if_func_true) {
 				if (unlock_mutex_before_return && func != init_empty_meta_information_struct) {
-					mutex_unlock(&(meta_information_pool_root[i].mutex));
+					spinlock_unlock(&(meta_information_root[i].lock));
 				}
 				return &meta_information_root[i];
 			}
 
 			if (func != init_empty_meta_information_struct)
-				mutex_unlock(&(meta_information_pool_root[i].mutex));
+				spinlock_unlock(&(meta_information_root[i].lock));
 		} else {
-			DEBUG("metadata_array_map %p \n", &meta_information_pool_root[i]);
+			TRACE("metadata_array_map %p \n", &meta_information_root[i]);
 		}
 	}
 
-	DEBUG("metadata_array_map : NULL \n");
+	TRACE("metadata_array_map : NULL \n");
 	return NULL;
 }
@@ -2,8 +2,12 @@
  * Le code contient des commentaires dont la source est le projet de pages de manuel Linux ou du manuel du programmeur POSIX
  * (The Linux man-pages project / POSIX Programmer's Manual)
  */
-#include <string.h> // memcpy(), memset()
+#define _GNU_SOURCE // Pour mremap()
+#include <string.h> // memset()
 #include <stdlib.h> // exit(), EXIT_FAILURE
+#include <stdint.h> // SIZE_MAX
+#include <errno.h> // errno, ENOMEM
+#include <sys/mman.h> // mmap(), mremap(), munmap(), mprotect(), madvise()
 #include "auxiliary_functions.private.h"
 #include "my_secmalloc.private.h"
 #include "basic_operations.private.h"
@@ -13,24 +17,130 @@
 
 // Allocation d'espace mémoire (allocation - découpage de la zone mémoire)
 void	*alloc(size_t size) {
-	LOG("alloc(%lu) \n", size);
+	int zeroed;
+	return alloc_and_get_zeroed(size, &zeroed);
+}
+
+/**
+ * La fonction alloc_and_get_zeroed() alloue size octets comme alloc(), et indique dans *zeroed
+ * si la mémoire allouée est déjà mise à zéro (1), ou si son contenu est inconnu (0).
+ */
+void	*alloc_and_get_zeroed(size_t size, int *zeroed) {
+	DEBUG("alloc(%lu) \n", size);
+	stats_count(STATS_ALLOCATIONS, size);
+
+	// Une grande allocation n'est pas découpée dans le pool de données
+	// (le contenu d'un nouveau mappage anonyme est initialisé à zéro)
+	*zeroed = 1;
+	if (size > mmap_threshold)
+		return alloc_mapped(size);
+
+	// Une allocation sur guard_sample_rate est placée contre une page de garde (si un emplacement est disponible)
+	if (size <= page_size && guard_sample()) {
+		void *guarded_ptr = alloc_guarded(size);
+		if (guarded_ptr != NULL)
+			return guarded_ptr;
+	}
+
+	// Une petite allocation occupe un emplacement d'un slab (un emplacement libre ne contient que des zéros)
+	if (slabs_enabled && size <= SLAB_SLOT_MAX_SIZE)
+		return alloc_slab_slot(size);
+
+	// Les blocs du pool de data conservent l'alignement de ALLOCATION_ALIGNMENT octets
+	// (mmap_threshold est borné, mais une taille proche de SIZE_MAX ne doit jamais être arrondie à une petite taille)
+	if (size > ALIGN_SIZE_MAX) {
+		errno = ENOMEM;
+		return NULL;
+	}
+	size = ALIGN_SIZE(size);
+
+	// Un bloc récemment libéré par ce thread est réutilisé sans passer par les listes de blocs libres
+	// (les blocs du cache ont été nettoyés lors de leur libération)
+	void *cached_ptr = thread_cache_pop(size);
+	if (cached_ptr != NULL)
+		return cached_ptr;
 
 	// Obtention d'un pointeur sur une structure des métadonnées d'une partie de la mémoire
 	// qui est libre et qui peut contenir au moins size octets.
 	struct meta_information *meta_information_struct = get_free_chunck(size);
-	LOG("Adresse du bloc de metadonnees obtenu %p\n", meta_information_struct);
+	DEBUG("Adresse du bloc de metadonnees obtenu %p\n", meta_information_struct);
 
 	// Un pointeur vers le début de la zone mémoire qui sera transmise à la fonction appelante
 	// (la zone mémoire vers laquelle pointe les métadonnées)
 	void *ptr = (void*) meta_information_struct->data_ptr;
-	LOG("Adresse du bloc de data obtenu : %p (taille du bloc : %lu) \n", ptr, meta_information_struct->size);
+	*zeroed = meta_information_struct->zeroed;
+	DEBUG("Adresse du bloc de data obtenu : %p (taille du bloc : %lu) \n", ptr, meta_information_struct->size);
 
 	memory_division(meta_information_struct, size);
-	mutex_unlock(&(meta_information_struct->mutex));
+	add_recent_block(meta_information_struct);
+	thread_cache_note_owned(meta_information_struct);
+	spinlock_unlock(&(meta_information_struct->lock));
 	return ptr;
 }
 
 
+/**
+ * La fonction alloc_aligned() alloue size octets dont l'adresse de début est un multiple de alignment (une puissance de 2).
+ * Le bloc est découpé directement à une adresse alignée du pool de data : l'espace qui précède cette adresse forme
+ * un bloc libre distinct (de taille au moins égale à celle d'un struct chunck), qui reste disponible pour d'autres
+ * allocations. Une allocation qui dépasse le seuil mmap_threshold dispose d'un mappage aligné.
+ * La fonction renvoie un pointeur vers la mémoire allouée, ou NULL en cas d'erreur.
+ */
+void	*alloc_aligned(size_t alignment, size_t size) {
+	DEBUG("alloc_aligned(%lu, %lu) \n", alignment, size);
+	if (alignment <= ALLOCATION_ALIGNMENT)
+		return alloc(size);
+
+	if (size <= mmap_threshold) {
+		if (size > ALIGN_SIZE_MAX) {
+			errno = ENOMEM;
+			return NULL;
+		}
+		size = ALIGN_SIZE(size);
+	}
+
+	// Taille d'un bloc libre qui contient forcément une adresse alignée suivie de size octets,
+	// précédée d'au moins 2 * sizeof(struct struct_canary) octets (données et canari du bloc libre qui précède)
+	size_t needed_size;
+	if (__builtin_add_overflow(size, alignment + 2 * sizeof(struct struct_canary), &needed_size))
+		return NULL;
+
+	stats_count(STATS_ALLOCATIONS, size);
+	if (needed_size > mmap_threshold)
+		return alloc_mapped_aligned(alignment, size);
+
+	struct meta_information *meta_information_struct = get_free_chunck(needed_size);
+	size_t data_address = (size_t) meta_information_struct->data_ptr;
+	if ((data_address & (alignment - 1)) != 0) {
+		size_t aligned_address = (data_address + 2 * sizeof(struct struct_canary) + alignment - 1) & ~(alignment - 1);
+
+		// Le bloc obtenu est divisé en 2 : le début reste un bloc libre, et le bloc aligné est ensuite divisé
+		// par memory_division() comme un bloc libre ordinaire
+		struct meta_information *aligned_meta_information_struct = get_empty_meta_information_struct(meta_information_struct);
+		aligned_meta_information_struct->data_ptr = (struct struct_canary *) aligned_address;
+		aligned_meta_information_struct->size = meta_information_struct->size - (aligned_address - data_address);
+		aligned_meta_information_struct->status = FREE;
+		aligned_meta_information_struct->zeroed = meta_information_struct->zeroed;
+
+		meta_information_struct->size = aligned_address - data_address - sizeof(struct struct_canary);
+		struct struct_canary *chunck = (struct struct_canary *) (aligned_address - sizeof(struct struct_canary));
+		chunck->canary = get_canary();
+
+		free_list_insert(meta_information_struct);
+		spinlock_unlock(&(meta_information_struct->lock));
+		meta_information_struct = aligned_meta_information_struct;
+	}
+
+	void *ptr = (void*) meta_information_struct->data_ptr;
+	DEBUG("Adresse du bloc aligne obtenu : %p (taille du bloc : %lu) \n", ptr, meta_information_struct->size);
+
+	memory_division(meta_information_struct, size);
+	add_recent_block(meta_information_struct);
+	thread_cache_note_owned(meta_information_struct);
+	spinlock_unlock(&(meta_information_struct->lock));
+	return ptr;
+}
+
 /**
  * La fonction memory_division() prend un bloc de métadonnées qui pointe vers une zone mémoire
  * d’au moins size octets. Si le nombre d'octets libres dans la zone mémoire est supérieur à size
@@ -39,7 +149,7 @@ void	*alloc(size_t size) {
  * Si une division a été effectuée, la fonction renvoie 1, sinon elle renvoie 0.
  */
 int  memory_division(struct meta_information *meta_information_struct, size_t size) {
-	LOG("memory_division(%p, %lu) \n", meta_information_struct, size);
+	DEBUG("memory_division(%p, %lu) \n", meta_information_struct, size);
 
 	// Variable booléenne pour indiquer si une division est nécessaire
 	int make_division = 0;
@@ -52,168 +162,270 @@ int  memory_division(struct meta_information *meta_information_struct, size_t si
 	// au moins 1 octet de data
 	if (meta_information_struct->size > size + sizeof(struct struct_canary)) {
 		make_division = 1;
-		LOG("Etant donne que la taille du bloc est %lu et que la taille demandee est %lu, nous divisons le bloc \n", meta_information_struct->size, size);
+		DEBUG("Etant donne que la taille du bloc est %lu et que la taille demandee est %lu, nous divisons le bloc \n", meta_information_struct->size, size);
 
 		next_meta_information_struct = get_empty_meta_information_struct(meta_information_struct);
-		LOG("L'adresse du bloc de metadonnees supplementaire qui pointera vers la zone memoire qui ne sera pas utilisee pour cette allocation : %p\n", next_meta_information_struct);
+		DEBUG("L'adresse du bloc de metadonnees supplementaire qui pointera vers la zone memoire qui ne sera pas utilisee pour cette allocation : %p\n", next_meta_information_struct);
 
 		next_meta_information_struct->size = meta_information_struct->size - (size + sizeof(struct struct_canary));
-		LOG("La taille de la zone memoire nouvellement creee apres la division (et qui n'est pas utilisee pour cette allocation) : %lu\n", next_meta_information_struct->size);
+		DEBUG("La taille de la zone memoire nouvellement creee apres la division (et qui n'est pas utilisee pour cette allocation) : %lu\n", next_meta_information_struct->size);
 	}
 	// Si l'espace mémoire n'est pas assez grand pour le couper en 2, mais qu'il s'agit du dernier espace mémoire,
 	// le problème peut être résolu en élargissant le pool de données.
 	else if (meta_information_struct->next == NULL) {
 		make_division = 1;
-		LOG("Le bloc de memoire n'est pas assez grand pour etre partitionne, mais comme il s'agit du dernier bloc, nous pouvons l'etendre afin que l'espace restant, "
+		DEBUG("Le bloc de memoire n'est pas assez grand pour etre partitionne, mais comme il s'agit du dernier bloc, nous pouvons l'etendre afin que l'espace restant, "
 				"le cas echeant, puisse etre utilise pour une allocation future. \n");
 
 		next_meta_information_struct = get_empty_meta_information_struct(meta_information_struct);
-		LOG("L'adresse du bloc de metadonnees supplementaire qui pointera vers la zone memoire qui ne sera pas utilisee pour cette allocation : %p\n", next_meta_information_struct);
+		DEBUG("L'adresse du bloc de metadonnees supplementaire qui pointera vers la zone memoire qui ne sera pas utilisee pour cette allocation : %p\n", next_meta_information_struct);
 
-		extend_data_pool(next_meta_information_struct, page_size, (meta_information_struct->size + page_size) - (size + sizeof(struct struct_canary)));
-		LOG("La taille de la zone memoire nouvellement creee apres la division (et qui n'est pas utilisee pour cette allocation) : %lu\n", next_meta_information_struct->size);
+		// L'ancien canari du bloc fera partie du bloc de données du nouveau bloc. L'adresse du bloc de données
+		// du nouveau bloc est connue avant l'élargissement, afin que son canari soit écrit directement à sa place
+		memset((void*) ((size_t) meta_information_struct->data_ptr + meta_information_struct->size), 0, sizeof(struct struct_canary));
+		next_meta_information_struct->data_ptr = (void*) ((size_t) meta_information_struct->data_ptr + size + sizeof(struct struct_canary));
+		extend_data_pool(next_meta_information_struct, page_size);
+		DEBUG("La taille de la zone memoire nouvellement creee apres la division (et qui n'est pas utilisee pour cette allocation) : %lu\n", next_meta_information_struct->size);
 	} else {
-		LOG("La zone memoire n'est pas assez grande pour etre divisible, et de plus, ce n'est pas le dernier bloc donc elle ne peut pas etre etendue en augmentant la taille du pool de data.\n");
+		DEBUG("La zone memoire n'est pas assez grande pour etre divisible, et de plus, ce n'est pas le dernier bloc donc elle ne peut pas etre etendue en augmentant la taille du pool de data.\n");
 	}
 
 	if (make_division) {
 		meta_information_struct->size = size;
 
 		// Initialiser les métadonnées du prochain morceau
+		// (son bloc de données est la fin de celui du bloc divisé, ou de la mémoire qui n'a jamais été utilisée)
 		next_meta_information_struct->status = FREE;
+		next_meta_information_struct->zeroed = meta_information_struct->zeroed;
 		next_meta_information_struct->data_ptr = (void*) ((size_t) meta_information_struct->data_ptr + size + sizeof(struct struct_canary));
-		LOG("L'adresse de la zone memoire vers laquelle pointe le prochain bloc de metadonnees : %p\n", meta_information_struct->data_ptr);
+		DEBUG("L'adresse de la zone memoire vers laquelle pointe le prochain bloc de metadonnees : %p\n", meta_information_struct->data_ptr);
 
 		struct struct_canary *chunck_ptr = (struct struct_canary *) ((size_t) next_meta_information_struct->data_ptr + next_meta_information_struct->size);
 		chunck_ptr->canary = get_canary();
 
-		mutex_unlock(&(next_meta_information_struct->mutex));
+		// Deux blocs libres ne doivent pas se suivre (lorsque my_realloc() réduit un bloc, le bloc suivant peut être libre)
+		struct meta_information *next_next_meta_information_struct = next_meta_information_struct->next;
+		if (next_next_meta_information_struct != NULL) {
+			spinlock_lock(&(next_next_meta_information_struct->lock));
+			if (next_next_meta_information_struct->status == FREE) {
+				free_list_remove(next_next_meta_information_struct);
+				absorb_next_chunck(next_meta_information_struct, next_next_meta_information_struct);
+			} else {
+				spinlock_unlock(&(next_next_meta_information_struct->lock));
+			}
+		}
+
+		free_list_insert(next_meta_information_struct);
+		spinlock_unlock(&(next_meta_information_struct->lock));
 	}
 
 	struct struct_canary *chunck = (struct struct_canary *) ((size_t) meta_information_struct->data_ptr + meta_information_struct->size);
 	chunck->canary = get_canary();
 
-	meta_information_struct->status = BUSY;
+	// Un bloc qui devient occupé est ajouté à l'index des pointeurs
+	meta_information_struct->zeroed = 0;
+	if (meta_information_struct->status != BUSY) {
+		meta_information_struct->status = BUSY;
+		pointer_index_insert(meta_information_struct);
+	}
 	return make_division;
 }
 
 // Libération d'une allocation mémoire
 int	clean(void *ptr) {
-	LOG("clean(%p) \n", ptr);
+	DEBUG("clean(%p) \n", ptr);
+
+	if (is_in_slab_pool(ptr))
+		return release_slab_slot(ptr);
+
+	// Un bloc obtenu récemment par ce thread est retrouvé (verrouillé) sans consulter l'index des pointeurs
+	struct meta_information *metadata_of_ptr = thread_cache_find_owned(ptr);
+	if (metadata_of_ptr == NULL) {
+		metadata_of_ptr = pointer_index_find(ptr);
+		if (metadata_of_ptr == NULL)
+			return 0;
 
-	struct meta_information *metadata_of_ptr = metadata_linked_list_map(meta_information_pool_root, 1, is_meta_information_of_memory_ptr, ptr, 0);
-	LOG("Le bloc de metadonnees qui pointe vers le bloc de donnees %p est %p \n", ptr, metadata_of_ptr);
+		spinlock_lock(&(metadata_of_ptr->lock));
+	}
+	DEBUG("Le bloc de metadonnees qui pointe vers le bloc de donnees %p est %p \n", ptr, metadata_of_ptr);
 
-	if (metadata_of_ptr == NULL || metadata_of_ptr->status == FREE)
+	// Un bloc qui se trouve dans le cache d'un thread (CACHED) a déjà été libéré
+	if ((metadata_of_ptr->status != BUSY && metadata_of_ptr->status != MAPPED && metadata_of_ptr->status != GUARDED)
+			|| metadata_of_ptr->data_ptr != ptr) {
+		spinlock_unlock(&(metadata_of_ptr->lock));
 		return 0;
+	}
 
-	// Marquer le morceau comme libre
-	metadata_of_ptr->status = FREE;
+	if (metadata_of_ptr->status == MAPPED) {
+		release_mapped_chunck(metadata_of_ptr);
+		return 1;
+	}
 
-	// Nettoyage de l’espace mémoire
-	// void * memset(void * block, int value, size_t size);
-	memset(ptr, 0, metadata_of_ptr->size);
+	if (metadata_of_ptr->status == GUARDED) {
+		release_guarded_chunck(metadata_of_ptr);
+		return 1;
+	}
 
 	if (overflow_detection(metadata_of_ptr, NULL)) {
-		mutex_unlock(&(metadata_of_ptr->mutex));
+		spinlock_unlock(&(metadata_of_ptr->lock));
 		LOG_ERROR("Detection d'overflow : bloc mémoire commençant à l'adresse %p (l'adresse du bloc de metadonnees concerne est %p) \n",
 				metadata_of_ptr->data_ptr, metadata_of_ptr);
 		exit(EXIT_FAILURE);
 	}
 
-	mutex_unlock(&(metadata_of_ptr->mutex));
+	// Le nettoyage d'un grand bloc peut être confié au thread de nettoyage différé
+	if (wipe_queue_push(metadata_of_ptr)) {
+		spinlock_unlock(&(metadata_of_ptr->lock));
+		return 1;
+	}
 
-	// Merge les blocs consécutifs
-	// L'idée est que si la libération du fragment actuel a lieu avant ou après d'autres fragments libres, ils peuvent être fusionnés.
-	// A cette occasion on parcourt toute la zone mémoire et on fusionne tous les blocs libres consécutifs
-	metadata_linked_list_map(meta_information_pool_root, 0, merge_if_free, NULL, 1);
+	// Nettoyage de l’espace mémoire
+	// void * memset(void * block, int value, size_t size);
+	memset(ptr, 0, metadata_of_ptr->size);
+	metadata_of_ptr->zeroed = 1;
+
+	if (thread_cache_push(metadata_of_ptr)) {
+		spinlock_unlock(&(metadata_of_ptr->lock));
+		return 1;
+	}
+
+	release_chunck(metadata_of_ptr);
 	return 1;
 }
 
-int merge_if_free(struct meta_information * meta_information_element, void *arg2) {
-	(void) arg2;
-	int flag = 0;
+/**
+ * La fonction release_chunck() rend au tas un bloc occupé (ou conservé dans le cache d'un thread,
+ * ou en attente de nettoyage différé) déjà nettoyé, dont le verrou est détenu par l'appelant. Le verrou est relâché.
+ */
+void	release_chunck(struct meta_information *meta_information_struct) {
+	// Le bloc est retiré de l'index des pointeurs : une seconde libération du même pointeur ne le trouvera plus
+	pointer_index_remove(meta_information_struct->data_ptr);
 
-	// Si le morceau est libre
-	if (meta_information_element-> status == FREE) {
-		size_t new_size = meta_information_element->size;
+	// Merge les blocs consécutifs
+	// Si la libération du fragment actuel a lieu avant ou après d'autres fragments libres, ils sont fusionnés.
+	// Comme deux blocs libres ne sont jamais consécutifs, il suffit de regarder le bloc précédent et le bloc suivant
+	// (la fusion de tous les blocs libres consécutifs du tas n'est faite que par secmalloc_coalesce())
+	struct meta_information *prev_meta_information_struct = lock_prev_chunck(meta_information_struct);
+	struct meta_information *next_meta_information_struct = meta_information_struct->next;
+	if (next_meta_information_struct != NULL)
+		spinlock_lock(&(next_meta_information_struct->lock));
 
-		// Puisque que metadata_element est libre,
-		// nous vérifions les morceaux de mémoire suivants, tant qu'ils sont libres
+	// Marquer le morceau comme libre
+	meta_information_struct->status = FREE;
 
-		struct meta_information *prev_prev_metadata_element = NULL;
-		struct meta_information *prev_metadata_element = meta_information_element;
-		struct meta_information *curr_metadata_element = prev_metadata_element->next;
-		struct meta_information *next_metadata_element = NULL;
+	if (next_meta_information_struct != NULL) {
+		if (next_meta_information_struct->status == FREE) {
+			free_list_remove(next_meta_information_struct);
+			absorb_next_chunck(meta_information_struct, next_meta_information_struct);
+		} else {
+			spinlock_unlock(&(next_meta_information_struct->lock));
+		}
+	}
 
-		if (curr_metadata_element != NULL)
-			mutex_lock(&(curr_metadata_element->mutex));
+	if (prev_meta_information_struct != NULL) {
+		if (prev_meta_information_struct->status == FREE) {
+			free_list_remove(prev_meta_information_struct);
+			absorb_next_chunck(prev_meta_information_struct, meta_information_struct);
+			meta_information_struct = prev_meta_information_struct;
+		} else {
+			spinlock_unlock(&(prev_meta_information_struct->lock));
+		}
+	}
 
-		while (curr_metadata_element != NULL) {
-			next_metadata_element = curr_metadata_element->next;
-			if (next_metadata_element != NULL)
-				mutex_lock(&(next_metadata_element->mutex));
+	free_list_insert(meta_information_struct);
+	spinlock_unlock(&(meta_information_struct->lock));
+}
 
-			if (prev_prev_metadata_element != NULL && prev_prev_metadata_element != meta_information_element) {
-				mutex_unlock(&(prev_prev_metadata_element->mutex));
-			}
+/**
+ * La fonction lock_prev_chunck() verrouille et renvoie le bloc précédent de meta_information_struct,
+ * dont le verrou est détenu par l'appelant (ou renvoie NULL s'il s'agit du premier bloc).
+ * Les verrous sont pris dans l'ordre de la liste chaînée : si le verrou du bloc précédent n'est pas
+ * immédiatement disponible, le verrou de meta_information_struct est relâché puis repris après lui.
+ * Le bloc précédent ne change qu'en présence du verrou de meta_information_struct, il est donc vérifié à nouveau.
+ */
+struct meta_information *lock_prev_chunck(struct meta_information *meta_information_struct) {
+	while (1) {
+		struct meta_information *prev_meta_information_struct = meta_information_struct->prev;
+		if (prev_meta_information_struct == NULL || spinlock_trylock(&(prev_meta_information_struct->lock)))
+			return prev_meta_information_struct;
 
-			if (curr_metadata_element->status == FREE) {
-				// Mise à jour de la taille de l'espace mémoire libre attendu après la fusion
-				new_size += curr_metadata_element->size + sizeof(struct struct_canary);
-
-				// Puisque nous fusionnons les espaces mémoire, ce bloc de métadonnées n'est plus nécessaire
-				curr_metadata_element->status = UNUSED;
-				curr_metadata_element->size = 0;
-				curr_metadata_element->data_ptr = NULL;
-				curr_metadata_element->prev = NULL;
-				curr_metadata_element->next = NULL;
-
-				// Lier l'élément précédent avec l'élément suivant
-				meta_information_element->next = next_metadata_element;
-				// Définir l'élément précédent de cet élément comme l'élément précédent de l'élément suivant
-				if (next_metadata_element != NULL) {
-					next_metadata_element->prev = meta_information_element;
-				}
-
-				DEBUG("new size : %lu consecutive check %p size %lu - status %u\n", new_size, curr_metadata_element,
-						curr_metadata_element->size, curr_metadata_element->status);
-
-				prev_prev_metadata_element = prev_metadata_element;
-				prev_metadata_element = curr_metadata_element;
-				curr_metadata_element = next_metadata_element;
-			} else {
-				if (next_metadata_element != NULL) {
-					mutex_unlock(&(next_metadata_element->mutex));
-				}
+		spinlock_unlock(&(meta_information_struct->lock));
+		spinlock_lock(&(prev_meta_information_struct->lock));
+		spinlock_lock(&(meta_information_struct->lock));
+
+		if (meta_information_struct->prev == prev_meta_information_struct)
+			return prev_meta_information_struct;
+
+		spinlock_unlock(&(prev_meta_information_struct->lock));
+	}
+}
+
+/**
+ * La fonction absorb_next_chunck() fusionne le bloc meta_information_struct avec le bloc suivant
+ * next_meta_information_struct. Les verrous des deux blocs sont détenus par l'appelant, et aucun
+ * des deux blocs n'appartient à une liste de blocs libres. Le bloc de métadonnées du bloc suivant,
+ * qui n'est plus nécessaire, devient inutilisé et son verrou est relâché.
+ */
+void	absorb_next_chunck(struct meta_information *meta_information_struct, struct meta_information *next_meta_information_struct) {
+	struct meta_information *next_next_meta_information_struct = next_meta_information_struct->next;
+
+	// Le canari du bloc suivant devient le canari du bloc fusionné, l'ancien canari fait partie du bloc de données
+	memset((void*) ((size_t) meta_information_struct->data_ptr + meta_information_struct->size), 0, sizeof(struct struct_canary));
+	meta_information_struct->zeroed = meta_information_struct->zeroed && next_meta_information_struct->zeroed;
+	meta_information_struct->size += sizeof(struct struct_canary) + next_meta_information_struct->size;
+	meta_information_struct->next = next_next_meta_information_struct;
 
-				mutex_unlock(&(curr_metadata_element->mutex));
+	if (next_next_meta_information_struct != NULL) {
+		spinlock_lock(&(next_next_meta_information_struct->lock));
+		next_next_meta_information_struct->prev = meta_information_struct;
+		spinlock_unlock(&(next_next_meta_information_struct->lock));
+	} else {
+		meta_information_struct->arena->meta_information_pool_last = meta_information_struct;
+	}
 
-				if (prev_metadata_element != meta_information_element) {
-					mutex_unlock(&(prev_metadata_element->mutex));
-				}
+	DEBUG("Fusion du bloc %p avec le bloc suivant %p, la nouvelle taille est %lu \n", meta_information_struct,
+			next_meta_information_struct, meta_information_struct->size);
 
-				flag = 1;
+	// Puisque nous fusionnons les espaces mémoire, ce bloc de métadonnées n'est plus nécessaire
+	next_meta_information_struct->status = UNUSED;
+	next_meta_information_struct->zeroed = 0;
+	next_meta_information_struct->size = 0;
+	next_meta_information_struct->data_ptr = NULL;
+	next_meta_information_struct->prev = NULL;
+	next_meta_information_struct->next = NULL;
+	spinlock_unlock(&(next_meta_information_struct->lock));
+	put_unused_meta_information_struct(next_meta_information_struct);
+}
+
+int merge_if_free(struct meta_information * meta_information_element, void *arg2) {
+	(void) arg2;
+
+	// Si le morceau est libre
+	if (meta_information_element->status == FREE) {
+		size_t size_before = meta_information_element->size;
+
+		// Puisque que metadata_element est libre,
+		// nous vérifions les morceaux de mémoire suivants, tant qu'ils sont libres
+		struct meta_information *next_metadata_element = meta_information_element->next;
+		while (next_metadata_element != NULL) {
+			spinlock_lock(&(next_metadata_element->lock));
+			if (next_metadata_element->status != FREE) {
+				spinlock_unlock(&(next_metadata_element->lock));
 				break;
 			}
-		}
 
-		if (!flag) {
-			if (prev_metadata_element != meta_information_element) {
-				mutex_unlock(&(prev_metadata_element->mutex));
-			}
+			// Le bloc change de taille, et donc potentiellement de classe de taille
+			if (meta_information_element->size == size_before)
+				free_list_remove(meta_information_element);
 
-			if (prev_prev_metadata_element != NULL && prev_prev_metadata_element != meta_information_element)
-				mutex_unlock(&(prev_prev_metadata_element->mutex));
+			free_list_remove(next_metadata_element);
+			absorb_next_chunck(meta_information_element, next_metadata_element);
+			next_metadata_element = meta_information_element->next;
 		}
 
-		// void * memcpy (void *restrict to, const void *restrict from, size_t size)
-		memcpy((void*) ((size_t) meta_information_element->data_ptr + new_size),
-				(void*) ((size_t) meta_information_element->data_ptr + meta_information_element->size), sizeof(struct struct_canary));
-
-		if (meta_information_element->size != new_size) {
-			LOG("Apres la tentative de fusion de blocs vides consécutifs, la nouvelle taille est %lu (taille précédente : %lu) \n", new_size, meta_information_element->size);
-			meta_information_element->size = new_size;
+		if (meta_information_element->size != size_before) {
+			DEBUG("Apres la tentative de fusion de blocs vides consécutifs, la nouvelle taille est %lu (taille précédente : %lu) \n", meta_information_element->size, size_before);
+			free_list_insert(meta_information_element);
 		}
 	}
 
@@ -221,51 +433,880 @@ int merge_if_free(struct meta_information * meta_information_element, void *arg2
 }
 
 /**
- * La fonction get_last_chunck_raw() renvoie un pointeur sur la structure des métadonnées
- * de la dernière partie de la mémoire.
+ * La fonction get_last_chunck_raw() renvoie un pointeur verrouillé sur la structure des métadonnées
+ * de la dernière partie de la mémoire de l'arène arena. Si ce bloc est libre, il est retiré de sa liste de blocs libres.
+ * S'il est occupé, un nouveau bloc de métadonnées (inutilisé) est ajouté à la fin de la liste chaînée.
  */
-struct meta_information	*get_last_chunck_raw() {
-	LOG("get_last_chunck_raw() \n");
+struct meta_information	*get_last_chunck_raw(struct arena *arena) {
+	DEBUG("get_last_chunck_raw(arene %lu) \n", arena->index);
 
-	struct meta_information	* last_meta_information_struct = NULL;
-	last_meta_information_struct = metadata_linked_list_map(meta_information_pool_root, 1,
-			is_last_meta_information_struct, NULL, 0);
+	// Le dernier bloc ne change qu'en présence de son verrou : nous le verrouillons puis nous vérifions
+	// qu'il s'agit toujours du dernier bloc
+	struct meta_information	*last_meta_information_struct = arena->meta_information_pool_last;
+	spinlock_lock(&(last_meta_information_struct->lock));
+	while (last_meta_information_struct != arena->meta_information_pool_last) {
+		spinlock_unlock(&(last_meta_information_struct->lock));
+		last_meta_information_struct = arena->meta_information_pool_last;
+		spinlock_lock(&(last_meta_information_struct->lock));
+	}
 
-	if (last_meta_information_struct->status == BUSY) {
-		return get_empty_meta_information_struct(last_meta_information_struct);
+	if (last_meta_information_struct->status != FREE) {
+		struct meta_information	*empty_meta_information_struct = get_empty_meta_information_struct(last_meta_information_struct);
+		spinlock_unlock(&(last_meta_information_struct->lock));
+		return empty_meta_information_struct;
 	}
 
+	free_list_remove(last_meta_information_struct);
 	return last_meta_information_struct;
 }
 
 struct meta_information	*get_free_chunck(size_t size) {
-	LOG("get_free_chunck(%lu) \n", size);
+	DEBUG("get_free_chunck(%lu) \n", size);
 
-	// Si le tas n'a pas encore été initialisé
-	if (data_pool == NULL || meta_information_pool_root == NULL) {
-		pthread_init_once();
-	}
+	// L'arène du thread appelant (le tas est initialisé si nécessaire)
+	struct arena *arena = get_thread_arena();
 
 	// Une tentative d'obtenir un pointeur sur une structure des métadonnées
 	// d'une partie de la mémoire qui est libre et qui peut contenir au moins size octets.
-	struct meta_information* item = metadata_linked_list_map(meta_information_pool_root, 1, is_meta_information_of_free_memory, (void*) &size, 0);
-	DEBUG("item : %p \n", item);
+	struct meta_information* item = free_list_take(arena, size);
+	TRACE("item : %p \n", item);
 
 	// Si aucun morceau de mémoire libre de la taille appropriée n'est trouvé
 	if (item == NULL) {
-		LOG("Aucun bloc libre de taille %lu n'a pu etre trouve \n", size);
+		DEBUG("Aucun bloc libre de taille %lu n'a pu etre trouve \n", size);
 
 		// tok_chunck : la taille de l'espace mémoire supplémentaire dont nous avons besoin
 		size_t tok_chunck = size + sizeof(struct struct_canary);
 		size_t delta_size =  get_delta_size(tok_chunck);
 
-		// Obtenir un pointeur vers le dernier morceau
-		struct meta_information* last_meta_information_item = get_last_chunck_raw();
-		extend_data_pool(last_meta_information_item, delta_size, last_meta_information_item->size + delta_size);
-		mutex_unlock(&(last_meta_information_item->mutex));
-
-		item = metadata_linked_list_map(meta_information_pool_root, 1, is_meta_information_of_free_memory, (void*) &size, 0);
-		DEBUG("last chunk %p\n", item);
+		// Obtenir un pointeur vers le dernier morceau, qui après l'élargissement du pool de data
+		// peut contenir au moins size octets
+		item = get_last_chunck_raw(arena);
+		extend_data_pool(item, delta_size);
+		TRACE("last chunk %p\n", item);
 	}
 	return item;
 }
+
+/* ****************************************************************** */
+/* ************ RESTITUTION DE LA MÉMOIRE AU SYSTÈME ***************** */
+/* ****************************************************************** */
+
+/**
+ * La fonction trim_data_pool() réduit le pool de data de l'arène arena si son dernier bloc est libre :
+ * ce bloc ne conserve que la fin de la page qui contient le début de son bloc de données, et les pages
+ * suivantes sont rendues au système. Elle renvoie le nombre d'octets rendus au système.
+ * Avec des pages de grande taille, seules les pages de grande taille entièrement situées après la fin du pool sont rendues.
+ */
+size_t	trim_data_pool(struct arena *arena) {
+	// Le pool de data n'est élargi qu'en présence du verrou du dernier bloc
+	struct meta_information	*last_meta_information_struct = arena->meta_information_pool_last;
+	spinlock_lock(&(last_meta_information_struct->lock));
+	while (last_meta_information_struct != arena->meta_information_pool_last) {
+		spinlock_unlock(&(last_meta_information_struct->lock));
+		last_meta_information_struct = arena->meta_information_pool_last;
+		spinlock_lock(&(last_meta_information_struct->lock));
+	}
+
+	if (last_meta_information_struct->status != FREE) {
+		spinlock_unlock(&(last_meta_information_struct->lock));
+		return 0;
+	}
+
+	// Le dernier bloc conserve au moins un octet de données
+	size_t data_offset = (size_t) last_meta_information_struct->data_ptr - (size_t) arena->data_pool;
+	size_t new_data_pool_size = get_delta_size(data_offset + 1 + sizeof(struct struct_canary));
+	if (new_data_pool_size >= arena->data_pool_size) {
+		spinlock_unlock(&(last_meta_information_struct->lock));
+		return 0;
+	}
+
+	// Le bloc change de taille, et donc potentiellement de classe de taille
+	free_list_remove(last_meta_information_struct);
+	last_meta_information_struct->size = new_data_pool_size - data_offset - sizeof(struct struct_canary);
+	struct struct_canary *chunck = (struct struct_canary *) ((size_t) last_meta_information_struct->data_ptr + last_meta_information_struct->size);
+	chunck->canary = get_canary();
+	free_list_insert(last_meta_information_struct);
+
+	size_t data_pool_committed_size = arena->data_pool_committed_size;
+	size_t old_data_pool_size = arena->data_pool_size;
+	arena->data_pool_size = new_data_pool_size;
+	arena->data_pool_committed_size = decommit_memeory(arena->data_pool, data_pool_committed_size, get_data_pool_commit_size(new_data_pool_size));
+	size_t released_size = data_pool_committed_size - arena->data_pool_committed_size;
+
+	// Avec des pages de grande taille, la fin de l'ancien pool peut rester accessible : elle est nettoyée (ancien canari
+	// et contenu du dernier bloc), afin qu'un prochain élargissement ne contienne que des zéros
+	size_t still_committed_end = (old_data_pool_size < arena->data_pool_committed_size) ? old_data_pool_size : arena->data_pool_committed_size;
+	if (still_committed_end > new_data_pool_size)
+		memset((void*) ((size_t) arena->data_pool + new_data_pool_size), 0, still_committed_end - new_data_pool_size);
+	spinlock_unlock(&(last_meta_information_struct->lock));
+
+	LOG("Le pool de data de l'arene %lu a ete reduit. La nouvelle taille est %lu \n", arena->index, new_data_pool_size);
+	return released_size;
+}
+
+/**
+ * La fonction release_free_pages() rend au système (MADV_DONTNEED) les pages entièrement contenues
+ * dans le bloc de données d'un bloc libre, dont le verrou est détenu par l'appelant. Le nombre d'octets
+ * rendus au système est ajouté à *released_size. Les pages restent accessibles (elles contiendront des zéros).
+ * Avec des pages de grande taille, seules les pages de grande taille entièrement libres sont rendues, afin que
+ * le noyau n'ait pas à les découper en pages ordinaires.
+ */
+int	release_free_pages(struct meta_information *meta_information_element, void *released_size) {
+	if (meta_information_element->status != FREE)
+		return 0;
+
+	size_t release_unit = huge_pages_enabled ? HUGE_PAGE_SIZE : page_size;
+	size_t first_page = ((size_t) meta_information_element->data_ptr + release_unit - 1) & ~(release_unit - 1);
+	size_t end_page = ((size_t) meta_information_element->data_ptr + meta_information_element->size) & ~(release_unit - 1);
+
+	if (end_page > first_page) {
+		// int madvise(void *addr, size_t length, int advice);
+		if (madvise((void*) first_page, end_page - first_page, MADV_DONTNEED) != 0)
+			handle_error("Echec de la fonction madvise()");
+
+		*((size_t*) released_size) += end_page - first_page;
+	}
+
+	return 0;
+}
+
+/* ****************************************************************** */
+/* ********************** GRANDES ALLOCATIONS *********************** */
+/* ****************************************************************** */
+
+// Une allocation de plus de mmap_threshold octets dispose de son propre mappage : elle ne fragmente pas
+// le pool de données et sa libération rend immédiatement la mémoire au système.
+// Son bloc de métadonnées (statut MAPPED) provient du pool de meta-information de l'arène du thread,
+// mais il n'appartient pas à la liste chaînée des blocs de l'arène (prev et next restent NULL).
+// Le canari est placé juste après les données, qui commencent au début du mappage (aligné sur une page).
+
+/**
+ * La fonction alloc_mapped() alloue size octets dans un nouveau mappage.
+ * Elle renvoie un pointeur vers la mémoire allouée, ou NULL si le mappage n'a pas pu être créé.
+ */
+void	*alloc_mapped(size_t size) {
+	return alloc_mapped_aligned(page_size, size);
+}
+
+/**
+ * La fonction alloc_mapped_aligned() alloue size octets dans un nouveau mappage dont l'adresse de début est un multiple
+ * de alignment (une puissance de 2). Si alignment est supérieur à la taille d'une page, un mappage plus grand de alignment
+ * octets est créé, puis les pages qui précèdent l'adresse alignée et celles qui suivent le bloc sont rendues au système.
+ * Elle renvoie un pointeur vers la mémoire allouée, ou NULL si le mappage n'a pas pu être créé.
+ */
+void	*alloc_mapped_aligned(size_t alignment, size_t size) {
+	size_t mapping_size = get_delta_size(size + sizeof(struct struct_canary));
+	size_t extra_size = (alignment > page_size) ? alignment : 0;
+	if (mapping_size < size || mapping_size + extra_size < mapping_size)
+		return NULL;
+
+	// Le contenu d'un mappage anonyme est initialisé à zéro
+	void *mmap_result = mmap(NULL, mapping_size + extra_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	if (mmap_result == MAP_FAILED) {
+		LOG_ERROR("alloc_mapped_aligned(%lu, %lu) : echec de la fonction mmap() \n", alignment, size);
+		return NULL;
+	}
+
+	if (extra_size != 0) {
+		size_t mapping_address = (size_t) mmap_result;
+		size_t aligned_address = (mapping_address + alignment - 1) & ~(alignment - 1);
+		if (aligned_address != mapping_address && munmap(mmap_result, aligned_address - mapping_address) != 0)
+			handle_error("Echec de la fonction munmap()");
+		if (munmap((void*) (aligned_address + mapping_size), mapping_address + extra_size - aligned_address) != 0)
+			handle_error("Echec de la fonction munmap()");
+		mmap_result = (void*) aligned_address;
+	}
+
+	struct meta_information *meta_information_struct = get_unused_meta_information_struct(get_thread_arena());
+	meta_information_struct->data_ptr = (struct struct_canary *) mmap_result;
+	meta_information_struct->size = size;
+	meta_information_struct->status = MAPPED;
+
+	struct struct_canary *chunck = (struct struct_canary *) ((size_t) mmap_result + size);
+	chunck->canary = get_canary();
+
+	pointer_index_insert(meta_information_struct);
+	add_recent_block(meta_information_struct);
+	spinlock_unlock(&(meta_information_struct->lock));
+
+	DEBUG("Grande allocation : %lu octets dans un mappage de %lu octets commencant a l'adresse %p \n", size, mapping_size, mmap_result);
+	return mmap_result;
+}
+
+/**
+ * La fonction resize_mapped_chunck() modifie la taille d'une grande allocation (statut MAPPED) dont le verrou
+ * est détenu par l'appelant. Si le nombre de pages change, le mappage est agrandi ou réduit avec mremap(),
+ * qui déplace les pages sans copier leur contenu. La fonction renvoie l'adresse (éventuellement nouvelle)
+ * du bloc de données, ou NULL si le mappage n'a pas pu être agrandi (le bloc d'origine reste alors intact).
+ */
+void	*resize_mapped_chunck(struct meta_information *meta_information_struct, size_t size) {
+	void *ptr = (void*) meta_information_struct->data_ptr;
+	size_t old_mapping_size = get_delta_size(meta_information_struct->size + sizeof(struct struct_canary));
+	size_t new_mapping_size = get_delta_size(size + sizeof(struct struct_canary));
+	if (new_mapping_size < size)
+		return NULL;
+
+	// Nettoyage de l'ancien canari et, si la taille diminue, des octets qui ne font plus partie du bloc
+	if (size < meta_information_struct->size)
+		memset((void*) ((size_t) ptr + size), 0, (meta_information_struct->size - size) + sizeof(struct struct_canary));
+	else
+		memset((void*) ((size_t) ptr + meta_information_struct->size), 0, sizeof(struct struct_canary));
+
+	if (new_mapping_size != old_mapping_size) {
+		// void *mremap(void *old_address, size_t old_size, size_t new_size, int flags);
+		// Les pages du mappage sont déplacées (si nécessaire) sans que leur contenu soit copié
+		void *mremap_result = mremap(ptr, old_mapping_size, new_mapping_size, MREMAP_MAYMOVE);
+		if (mremap_result == MAP_FAILED) {
+			if (size < meta_information_struct->size)
+				handle_error("Echec de la fonction mremap()");
+
+			struct struct_canary *chunck = (struct struct_canary *) ((size_t) ptr + meta_information_struct->size);
+			chunck->canary = get_canary();
+			LOG_ERROR("resize_mapped_chunck(%p, %lu) : echec de la fonction mremap() \n", ptr, size);
+			return NULL;
+		}
+
+		if (mremap_result != ptr) {
+			pointer_index_remove(ptr);
+			meta_information_struct->data_ptr = (struct struct_canary *) mremap_result;
+			pointer_index_insert(meta_information_struct);
+			ptr = mremap_result;
+		}
+	}
+
+	meta_information_struct->size = size;
+	struct struct_canary *chunck = (struct struct_canary *) ((size_t) ptr + size);
+	chunck->canary = get_canary();
+
+	DEBUG("Grande allocation redimensionnee : %lu octets dans un mappage de %lu octets commencant a l'adresse %p \n", size, new_mapping_size, ptr);
+	return ptr;
+}
+
+/**
+ * La fonction release_mapped_chunck() rend au système le mappage d'une grande allocation (statut MAPPED)
+ * dont le verrou est détenu par l'appelant. Le bloc de métadonnées redevient inutilisé et son verrou est relâché.
+ */
+void	release_mapped_chunck(struct meta_information *meta_information_struct) {
+	if (overflow_detection(meta_information_struct, NULL)) {
+		spinlock_unlock(&(meta_information_struct->lock));
+		LOG_ERROR("Detection d'overflow : bloc mémoire commençant à l'adresse %p (l'adresse du bloc de metadonnees concerne est %p) \n",
+				meta_information_struct->data_ptr, meta_information_struct);
+		exit(EXIT_FAILURE);
+	}
+
+	pointer_index_remove(meta_information_struct->data_ptr);
+
+	// Les pages rendues au système ne sont pas nettoyées : un nouveau mappage anonyme est toujours initialisé à zéro
+	// int munmap(void *addr, size_t len);
+	int munmap_result = munmap(meta_information_struct->data_ptr, get_delta_size(meta_information_struct->size + sizeof(struct struct_canary)));
+	if (munmap_result != 0)
+		handle_error("Echec de la fonction munmap()");
+
+	meta_information_struct->data_ptr = NULL;
+	meta_information_struct->size = 0;
+	meta_information_struct->status = UNUSED;
+	spinlock_unlock(&(meta_information_struct->lock));
+
+	put_unused_meta_information_struct(meta_information_struct);
+}
+
+/* ****************************************************************** */
+/* ********* ALLOCATIONS ÉCHANTILLONNÉES (PAGES DE GARDE) *********** */
+/* ****************************************************************** */
+
+// Lorsque l'échantillonnage est activé (MSM_GUARD_SAMPLE_RATE), une allocation sur guard_sample_rate
+// (d'au plus une page) est placée dans un emplacement du pool guard_pool, à la fin d'une page de données
+// suivie d'une page de garde. Un overflow est détecté par le noyau (SIGSEGV) à l'instruction fautive,
+// au lieu d'être détecté par la vérification du canari lors de la libération ou du parcours du tas.
+// Après la libération, la page de données redevient inaccessible : une utilisation après libération
+// provoque elle aussi une erreur de segmentation, jusqu'à la réutilisation de l'emplacement.
+// Le bloc de métadonnées (statut GUARDED) n'appartient pas à la liste chaînée des blocs de l'arène.
+
+/**
+ * La fonction guard_sample() renvoie 1 si l'allocation en cours du thread appelant doit être échantillonnée.
+ */
+int	guard_sample() {
+	if (guard_sample_rate == 0)
+		return 0;
+
+	guard_sample_counter++;
+	return (guard_sample_counter % guard_sample_rate == 0);
+}
+
+/**
+ * La fonction alloc_guarded() place une allocation de size octets (au plus une page) contre une page de garde.
+ * Elle renvoie un pointeur vers la mémoire allouée, ou NULL si tous les emplacements du pool sont utilisés.
+ */
+void	*alloc_guarded(size_t size) {
+	mutex_lock(&(guard_pool.mutex));
+
+	size_t slot_index = GUARD_POOL_SLOTS_NB;
+	for (size_t i = 0; i < GUARD_POOL_SLOTS_NB; i++) {
+		size_t index = (guard_pool.next_slot + i) % GUARD_POOL_SLOTS_NB;
+		if ((guard_pool.used_slots[index / BITMAP_WORD_BITS] & ((size_t) 1 << (index % BITMAP_WORD_BITS))) == 0) {
+			slot_index = index;
+			break;
+		}
+	}
+
+	if (slot_index == GUARD_POOL_SLOTS_NB) {
+		mutex_unlock(&(guard_pool.mutex));
+		DEBUG("Tous les emplacements du pool des allocations echantillonnees sont utilises \n");
+		return NULL;
+	}
+
+	guard_pool.used_slots[slot_index / BITMAP_WORD_BITS] |= (size_t) 1 << (slot_index % BITMAP_WORD_BITS);
+	guard_pool.next_slot = (slot_index + 1) % GUARD_POOL_SLOTS_NB;
+	mutex_unlock(&(guard_pool.mutex));
+
+	// La page de garde qui suit la page de données reste inaccessible (PROT_NONE)
+	char *data_page = guard_pool.slots + slot_index * 2 * page_size;
+	if (mprotect(data_page, page_size, PROT_READ | PROT_WRITE) != 0)
+		handle_error("Echec de la fonction mprotect()");
+
+	// Les données sont placées à une adresse alignée : jusqu'à ALLOCATION_ALIGNMENT - 1 octets les séparent de la page de garde.
+	// Ces octets contiennent un motif, vérifié comme un canari (lors de la libération et du parcours du tas)
+	void *ptr = (void*) (data_page + page_size - ((size + ALLOCATION_ALIGNMENT - 1) & ~((size_t) ALLOCATION_ALIGNMENT - 1)));
+	for (size_t address = (size_t) ptr + size; address < (size_t) data_page + page_size; address++)
+		*((unsigned char *) address) = get_guard_slack_byte(address);
+
+	struct meta_information *meta_information_struct = get_unused_meta_information_struct(get_thread_arena());
+	meta_information_struct->data_ptr = (struct struct_canary *) ptr;
+	meta_information_struct->size = size;
+	meta_information_struct->status = GUARDED;
+
+	pointer_index_insert(meta_information_struct);
+	spinlock_unlock(&(meta_information_struct->lock));
+
+	DEBUG("Allocation echantillonnee : %lu octets a l'adresse %p (emplacement %lu) \n", size, ptr, slot_index);
+	return ptr;
+}
+
+/**
+ * La fonction release_guarded_chunck() libère une allocation échantillonnée (statut GUARDED) dont le verrou
+ * est détenu par l'appelant. Le bloc de métadonnées redevient inutilisé et son verrou est relâché.
+ */
+void	release_guarded_chunck(struct meta_information *meta_information_struct) {
+	if (overflow_detection(meta_information_struct, NULL)) {
+		spinlock_unlock(&(meta_information_struct->lock));
+		LOG_ERROR("Detection d'overflow : bloc mémoire commençant à l'adresse %p (l'adresse du bloc de metadonnees concerne est %p) \n",
+				meta_information_struct->data_ptr, meta_information_struct);
+		exit(EXIT_FAILURE);
+	}
+
+	pointer_index_remove(meta_information_struct->data_ptr);
+
+	size_t slot_index = ((size_t) meta_information_struct->data_ptr - (size_t) guard_pool.slots) / (2 * page_size);
+	char *data_page = guard_pool.slots + slot_index * 2 * page_size;
+
+	// int madvise(void *addr, size_t length, int advice);
+	// MADV_DONTNEED : les pages d'un mappage anonyme privé sont libérées, et seront initialisées à zéro
+	// lors du prochain accès (les données n'ont donc pas besoin d'être nettoyées)
+	if (madvise(data_page, page_size, MADV_DONTNEED) != 0)
+		handle_error("Echec de la fonction madvise()");
+
+	if (mprotect(data_page, page_size, PROT_NONE) != 0)
+		handle_error("Echec de la fonction mprotect()");
+
+	meta_information_struct->data_ptr = NULL;
+	meta_information_struct->size = 0;
+	meta_information_struct->status = UNUSED;
+	spinlock_unlock(&(meta_information_struct->lock));
+
+	put_unused_meta_information_struct(meta_information_struct);
+
+	mutex_lock(&(guard_pool.mutex));
+	guard_pool.used_slots[slot_index / BITMAP_WORD_BITS] &= ~((size_t) 1 << (slot_index % BITMAP_WORD_BITS));
+	mutex_unlock(&(guard_pool.mutex));
+}
+
+/* ****************************************************************** */
+/* ****************** SLABS (PETITES ALLOCATIONS) ******************* */
+/* ****************************************************************** */
+
+// Lorsque les slabs sont activés (MSM_SLABS), une allocation d'au plus SLAB_SLOT_MAX_SIZE octets occupe un emplacement
+// d'un slab de la classe correspondante de l'arène du thread : l'allocation et la libération ne modifient que la bitmap
+// du slab, en présence du verrou de la classe. Le canari compact d'un emplacement occupé (2 octets, qui dépendent
+// de l'adresse de l'emplacement) est vérifié lors de la libération, par secmalloc_check() et par le thread de parcours
+// du tas. Un emplacement libre ne contient que des zéros : il est nettoyé, canari compris, lors de sa libération.
+// Un slab qui devient vide est rendu au pool de slabs, sauf s'il s'agit du dernier slab non plein de sa classe.
+// Ordre de prise des verrous : le verrou du pool de slabs est pris après le verrou d'une classe.
+
+/**
+ * La fonction is_in_slab_pool() indique si ptr pointe vers un slab.
+ */
+int	is_in_slab_pool(void *ptr) {
+	return slabs_enabled && (size_t) ptr >= (size_t) slab_pool.slabs
+			&& (size_t) ptr < (size_t) slab_pool.slabs + __atomic_load_n(&(slab_pool.slabs_nb), __ATOMIC_ACQUIRE) * SLAB_SIZE;
+}
+
+/**
+ * La fonction get_slab_canary() renvoie la valeur du canari compact de l'emplacement slot.
+ */
+uint16_t	get_slab_canary(void *slot) {
+	return (uint16_t) ((((size_t) get_canary() ^ (size_t) slot) * 0x9E3779B97F4A7C15UL) >> 48);
+}
+
+/**
+ * La fonction slab_slot_overflow_detection() renvoie 1 si le canari de l'emplacement occupé slot
+ * (de slot_size octets) a été écrasé, 0 sinon.
+ */
+int	slab_slot_overflow_detection(void *slot, size_t slot_size) {
+	uint16_t *canary = (uint16_t *) ((size_t) slot + slot_size - SLAB_CANARY_SIZE);
+	return (*canary != get_slab_canary(slot));
+}
+
+/**
+ * La fonction slab_overflow_detection() vérifie le canari de chaque emplacement occupé du slab slab, dont le verrou
+ * de la classe est détenu par l'appelant. Elle renvoie le nombre de canaris écrasés.
+ */
+size_t	slab_overflow_detection(struct slab *slab) {
+	char *slab_data = slab_pool.slabs + (size_t) (slab - slab_pool.descriptors) * SLAB_SIZE;
+	size_t errors_nb = 0;
+
+	for (size_t i = 0; i < slab->slots_nb; i++) {
+		if ((slab->used_slots[i / BITMAP_WORD_BITS] & ((size_t) 1 << (i % BITMAP_WORD_BITS))) == 0)
+			continue;
+
+		void *slot = slab_data + i * slab->slot_size;
+		if (slab_slot_overflow_detection(slot, slab->slot_size)) {
+			LOG_ERROR("Detection d'overflow : emplacement commençant à l'adresse %p (slab %p) \n", slot, slab);
+			errors_nb++;
+		}
+	}
+
+	return errors_nb;
+}
+
+/**
+ * La fonction lock_slab_class() prend le verrou de la classe de l'arène à laquelle appartient le slab slab, et renvoie
+ * cette classe. Elle renvoie NULL si le slab est vide et n'appartient à aucune arène, ou si trylock est différent de 0
+ * et que le verrou n'est pas immédiatement disponible. L'arène du slab ne change qu'en présence du verrou de sa classe :
+ * elle est donc vérifiée à nouveau après la prise du verrou.
+ */
+struct slab_class	*lock_slab_class(struct slab *slab, int trylock) {
+	while (1) {
+		struct arena *arena = __atomic_load_n(&(slab->arena), __ATOMIC_ACQUIRE);
+		if (arena == NULL)
+			return NULL;
+
+		struct slab_class *slab_class = &(arena->slab_classes[__atomic_load_n(&(slab->class_index), __ATOMIC_RELAXED)]);
+		if (trylock) {
+			if (!mutex_trylock(&(slab_class->mutex)))
+				return NULL;
+		} else {
+			mutex_lock(&(slab_class->mutex));
+		}
+
+		if (slab->arena == arena && &(arena->slab_classes[slab->class_index]) == slab_class)
+			return slab_class;
+
+		mutex_unlock(&(slab_class->mutex));
+	}
+}
+
+void	slab_list_insert(struct slab **head, struct slab *slab) {
+	slab->prev = NULL;
+	slab->next = *head;
+	if (*head != NULL)
+		(*head)->prev = slab;
+	*head = slab;
+}
+
+void	slab_list_remove(struct slab **head, struct slab *slab) {
+	if (slab->prev != NULL)
+		slab->prev->next = slab->next;
+	else
+		*head = slab->next;
+
+	if (slab->next != NULL)
+		slab->next->prev = slab->prev;
+
+	slab->prev = NULL;
+	slab->next = NULL;
+}
+
+/**
+ * La fonction new_slab() ajoute un slab vide à la classe d'indice class_index de l'arène arena, dont le verrou
+ * est détenu par l'appelant : un slab vide du pool est réutilisé, ou un nouveau slab est créé à la fin du pool.
+ */
+struct slab	*new_slab(struct arena *arena, size_t class_index) {
+	mutex_lock(&(slab_pool.mutex));
+
+	struct slab *slab = slab_pool.empty_slabs;
+	if (slab != NULL) {
+		slab_pool.empty_slabs = slab->next;
+	} else {
+		size_t slabs_nb = slab_pool.slabs_nb;
+		slab_pool.slabs_committed_size = commit_memeory(slab_pool.slabs, slab_pool.slabs_committed_size,
+				(slabs_nb + 1) * SLAB_SIZE, SLAB_POOL_RESERVED_SIZE);
+		slab_pool.descriptors_committed_size = commit_memeory(slab_pool.descriptors, slab_pool.descriptors_committed_size,
+				get_delta_size((slabs_nb + 1) * sizeof(struct slab)), SLAB_DESCRIPTORS_RESERVED_SIZE);
+
+		slab = &(slab_pool.descriptors[slabs_nb]);
+		__atomic_store_n(&(slab_pool.slabs_nb), slabs_nb + 1, __ATOMIC_RELEASE);
+		LOG("Creation du slab %lu (classe de %lu octets) \n", slabs_nb, (class_index + 1) * ALLOCATION_ALIGNMENT);
+	}
+	mutex_unlock(&(slab_pool.mutex));
+
+	// Les pages d'un slab rendues au système sont de nouveau accessibles (elles ne contiennent que des zéros)
+	slab->slot_size = (uint16_t) ((class_index + 1) * ALLOCATION_ALIGNMENT);
+	slab->slots_nb = (uint16_t) (SLAB_SIZE / slab->slot_size);
+	slab->used_slots_nb = 0;
+	slab->class_index = (uint8_t) class_index;
+	slab->released = 0;
+	memset(slab->used_slots, 0, sizeof(slab->used_slots));
+	__atomic_store_n(&(slab->arena), arena, __ATOMIC_RELEASE);
+
+	slab_list_insert(&(arena->slab_classes[class_index].partial_slabs), slab);
+	return slab;
+}
+
+/**
+ * La fonction alloc_slab_slot() alloue un emplacement d'au moins size octets (au plus SLAB_SLOT_MAX_SIZE)
+ * dans un slab de l'arène du thread appelant. La mémoire renvoyée ne contient que des zéros.
+ */
+void	*alloc_slab_slot(size_t size) {
+	struct arena *arena = get_thread_arena();
+	size_t class_index = (size + SLAB_CANARY_SIZE - 1) / ALLOCATION_ALIGNMENT;
+	struct slab_class *slab_class = &(arena->slab_classes[class_index]);
+
+	mutex_lock(&(slab_class->mutex));
+	struct slab *slab = slab_class->partial_slabs;
+	if (slab == NULL)
+		slab = new_slab(arena, class_index);
+
+	// Premier emplacement libre (un slab non plein en contient au moins un)
+	size_t slot_index = 0;
+	for (size_t i = 0; i < SLAB_SLOTS_MAX_NB / BITMAP_WORD_BITS; i++) {
+		if (~(slab->used_slots[i]) != 0) {
+			slot_index = i * BITMAP_WORD_BITS + (size_t) __builtin_ctzl(~(slab->used_slots[i]));
+			break;
+		}
+	}
+
+	slab->used_slots[slot_index / BITMAP_WORD_BITS] |= (size_t) 1 << (slot_index % BITMAP_WORD_BITS);
+	slab->used_slots_nb++;
+	if (slab->used_slots_nb == slab->slots_nb)
+		slab_list_remove(&(slab_class->partial_slabs), slab);
+
+	void *slot = slab_pool.slabs + (size_t) (slab - slab_pool.descriptors) * SLAB_SIZE + slot_index * slab->slot_size;
+	uint16_t *canary = (uint16_t *) ((size_t) slot + slab->slot_size - SLAB_CANARY_SIZE);
+	*canary = get_slab_canary(slot);
+	mutex_unlock(&(slab_class->mutex));
+
+	DEBUG("Emplacement %p (%u octets) obtenu depuis le slab %p \n", slot, slab->slot_size, slab);
+	return slot;
+}
+
+/**
+ * La fonction release_slab_slot() libère l'emplacement de slab pointé par ptr. Elle renvoie 1 si l'emplacement
+ * était occupé, ou 0 si ptr ne pointe pas vers le début d'un emplacement occupé (double free ou pointeur invalide).
+ * Le processus se termine si le canari de l'emplacement a été écrasé.
+ */
+int	release_slab_slot(void *ptr) {
+	size_t slab_index = ((size_t) ptr - (size_t) slab_pool.slabs) / SLAB_SIZE;
+	struct slab *slab = &(slab_pool.descriptors[slab_index]);
+
+	struct slab_class *slab_class = lock_slab_class(slab, 0);
+	if (slab_class == NULL)
+		return 0;
+
+	size_t offset = (size_t) ptr - (size_t) slab_pool.slabs - slab_index * SLAB_SIZE;
+	size_t slot_index = offset / slab->slot_size;
+	if (offset % slab->slot_size != 0 || slot_index >= slab->slots_nb
+			|| (slab->used_slots[slot_index / BITMAP_WORD_BITS] & ((size_t) 1 << (slot_index % BITMAP_WORD_BITS))) == 0) {
+		mutex_unlock(&(slab_class->mutex));
+		return 0;
+	}
+
+	if (slab_slot_overflow_detection(ptr, slab->slot_size)) {
+		mutex_unlock(&(slab_class->mutex));
+		LOG_ERROR("Detection d'overflow : emplacement commençant à l'adresse %p (slab %p) \n", ptr, slab);
+		exit(EXIT_FAILURE);
+	}
+
+	// Nettoyage de l'emplacement, canari compris
+	// void * memset(void * block, int value, size_t size);
+	memset(ptr, 0, slab->slot_size);
+
+	if (slab->used_slots_nb == slab->slots_nb)
+		slab_list_insert(&(slab_class->partial_slabs), slab);
+	slab->used_slots[slot_index / BITMAP_WORD_BITS] &= ~((size_t) 1 << (slot_index % BITMAP_WORD_BITS));
+	slab->used_slots_nb--;
+
+	// Un slab vide est rendu au pool, sauf s'il est le dernier slab non plein de sa classe
+	if (slab->used_slots_nb == 0 && (slab->prev != NULL || slab->next != NULL)) {
+		slab_list_remove(&(slab_class->partial_slabs), slab);
+		__atomic_store_n(&(slab->arena), NULL, __ATOMIC_RELEASE);
+
+		mutex_lock(&(slab_pool.mutex));
+		slab->next = slab_pool.empty_slabs;
+		slab_pool.empty_slabs = slab;
+		mutex_unlock(&(slab_pool.mutex));
+	}
+
+	mutex_unlock(&(slab_class->mutex));
+	DEBUG("Emplacement %p du slab %p libere \n", ptr, slab);
+	return 1;
+}
+
+/**
+ * La fonction get_slab_slot_size() renvoie le nombre d'octets utilisables de l'emplacement de slab pointé par ptr
+ * (canari non compris), ou 0 si ptr ne pointe pas vers le début d'un emplacement occupé.
+ */
+size_t	get_slab_slot_size(void *ptr) {
+	size_t slab_index = ((size_t) ptr - (size_t) slab_pool.slabs) / SLAB_SIZE;
+	struct slab *slab = &(slab_pool.descriptors[slab_index]);
+
+	struct slab_class *slab_class = lock_slab_class(slab, 0);
+	if (slab_class == NULL)
+		return 0;
+
+	size_t offset = (size_t) ptr - (size_t) slab_pool.slabs - slab_index * SLAB_SIZE;
+	size_t slot_index = offset / slab->slot_size;
+	size_t usable_size = 0;
+	if (offset % slab->slot_size == 0 && slot_index < slab->slots_nb
+			&& (slab->used_slots[slot_index / BITMAP_WORD_BITS] & ((size_t) 1 << (slot_index % BITMAP_WORD_BITS))) != 0)
+		usable_size = slab->slot_size - SLAB_CANARY_SIZE;
+
+	mutex_unlock(&(slab_class->mutex));
+	return usable_size;
+}
+
+/**
+ * La fonction release_empty_slabs() rend au système (MADV_DONTNEED) les pages des slabs vides du pool.
+ * Elle renvoie le nombre d'octets rendus au système.
+ */
+size_t	release_empty_slabs() {
+	// Une page partagée par plusieurs slabs n'est jamais rendue
+	if (!slabs_enabled || SLAB_SIZE % page_size != 0)
+		return 0;
+
+	size_t released_size = 0;
+	mutex_lock(&(slab_pool.mutex));
+	for (struct slab *slab = slab_pool.empty_slabs; slab != NULL; slab = slab->next) {
+		if (slab->released)
+			continue;
+
+		// int madvise(void *addr, size_t length, int advice);
+		if (madvise(slab_pool.slabs + (size_t) (slab - slab_pool.descriptors) * SLAB_SIZE, SLAB_SIZE, MADV_DONTNEED) != 0)
+			handle_error("Echec de la fonction madvise()");
+
+		slab->released = 1;
+		released_size += SLAB_SIZE;
+	}
+	mutex_unlock(&(slab_pool.mutex));
+
+	return released_size;
+}
+
+/* ****************************************************************** */
+/* *********************** NETTOYAGE DIFFÉRÉ ************************ */
+/* ****************************************************************** */
+
+// Lorsque le nettoyage différé est activé (MSM_DEFERRED_WIPE), un bloc libéré d'au moins deferred_wipe_min_size
+// octets n'est pas nettoyé par my_free() : après la vérification de son canari, il prend le statut WIPING
+// et il est ajouté à la file wipe_queue. Il reste dans l'index des pointeurs (une seconde libération est détectée),
+// mais il n'appartient à aucune liste de blocs libres et n'est pas fusionné avec ses voisins : il ne peut donc
+// pas être réutilisé avant d'avoir été nettoyé par le thread de nettoyage, qui le rend ensuite au tas.
+// Ordre de prise des verrous : le verrou de la file est pris après le verrou d'un bloc de métadonnées.
+
+/**
+ * La fonction wipe_queue_push() ajoute à la file de nettoyage un bloc occupé dont le verrou est détenu
+ * par l'appelant. Elle renvoie 1 si le bloc a été ajouté à la file, ou 0 s'il doit être nettoyé
+ * immédiatement (nettoyage différé désactivé, bloc trop petit ou file pleine).
+ */
+int	wipe_queue_push(struct meta_information *meta_information_struct) {
+	if (deferred_wipe_min_size == 0 || meta_information_struct->size < deferred_wipe_min_size)
+		return 0;
+
+	mutex_lock(&(wipe_queue.mutex));
+	if (wipe_queue.size + meta_information_struct->size > WIPE_QUEUE_MAX_SIZE) {
+		mutex_unlock(&(wipe_queue.mutex));
+		return 0;
+	}
+
+	meta_information_struct->status = WIPING;
+	meta_information_struct->next_free = wipe_queue.head;
+	wipe_queue.head = meta_information_struct;
+	wipe_queue.size += meta_information_struct->size;
+
+	// int pthread_cond_signal(pthread_cond_t *cond);
+	pthread_cond_signal(&(wipe_queue.cond));
+	mutex_unlock(&(wipe_queue.mutex));
+
+	DEBUG("Bloc %p (taille : %lu) ajoute a la file de nettoyage differe \n", meta_information_struct->data_ptr, meta_information_struct->size);
+	return 1;
+}
+
+/**
+ * La fonction deferred_wipe() est exécutée par le thread de nettoyage différé : elle nettoie les blocs
+ * de la file de nettoyage et les rend au tas.
+ */
+void	*deferred_wipe(void *arg) {
+	(void) arg;
+
+	while (1) {
+		mutex_lock(&(wipe_queue.mutex));
+		while (wipe_queue.head == NULL) {
+			// int pthread_cond_wait(pthread_cond_t *restrict cond, pthread_mutex_t *restrict mutex);
+			pthread_cond_wait(&(wipe_queue.cond), &(wipe_queue.mutex));
+		}
+
+		// Toute la file est prise en une fois, le verrou de la file n'est pas conservé pendant le nettoyage
+		struct meta_information *meta_information_struct = wipe_queue.head;
+		wipe_queue.head = NULL;
+		mutex_unlock(&(wipe_queue.mutex));
+
+		size_t wiped_size = 0;
+		while (meta_information_struct != NULL) {
+			spinlock_lock(&(meta_information_struct->lock));
+			struct meta_information *next_meta_information_struct = meta_information_struct->next_free;
+			wiped_size += meta_information_struct->size;
+
+			meta_information_struct->next_free = NULL;
+			// void * memset(void * block, int value, size_t size);
+			memset(meta_information_struct->data_ptr, 0, meta_information_struct->size);
+			meta_information_struct->zeroed = 1;
+			release_chunck(meta_information_struct);
+
+			meta_information_struct = next_meta_information_struct;
+		}
+
+		mutex_lock(&(wipe_queue.mutex));
+		wipe_queue.size -= wiped_size;
+		mutex_unlock(&(wipe_queue.mutex));
+	}
+}
+
+/* ****************************************************************** */
+/* ************************ CACHE PAR THREAD ************************ */
+/* ****************************************************************** */
+
+// Chaque thread conserve les petits blocs qu'il libère (après vérification du canari et nettoyage)
+// afin de les réutiliser lors de ses prochaines allocations sans accéder aux listes de blocs libres.
+// Les blocs du cache restent dans l'index des pointeurs avec le statut CACHED, ce qui permet
+// de détecter un double free et évite de modifier l'index lors de leur réutilisation.
+
+/**
+ * La fonction thread_cache_pop() renvoie un bloc du cache du thread appelant qui peut contenir
+ * size octets, ou NULL si le cache ne contient aucun bloc suffisamment grand de la classe de taille correspondante.
+ */
+void	*thread_cache_pop(size_t size) {
+	size_t index = (size - 1) / THREAD_CACHE_GRANULARITY;
+	if (thread_cache_capacity == 0 || size == 0 || index >= THREAD_CACHE_BUCKETS_NB)
+		return NULL;
+
+	// Les blocs d'une même case n'ont pas tous la même taille : la case contient au plus
+	// thread_cache_capacity blocs, elle est parcourue jusqu'au premier bloc suffisamment grand
+	struct meta_information **meta_information_struct_ptr = &(thread_cache.buckets[index]);
+	while (*meta_information_struct_ptr != NULL && (*meta_information_struct_ptr)->size < size)
+		meta_information_struct_ptr = &((*meta_information_struct_ptr)->next_free);
+
+	struct meta_information *meta_information_struct = *meta_information_struct_ptr;
+	if (meta_information_struct == NULL)
+		return NULL;
+
+	*meta_information_struct_ptr = meta_information_struct->next_free;
+	thread_cache.blocks_nb[index]--;
+
+	spinlock_lock(&(meta_information_struct->lock));
+	meta_information_struct->next_free = NULL;
+	meta_information_struct->status = BUSY;
+	meta_information_struct->zeroed = 0;
+	add_recent_block(meta_information_struct);
+	thread_cache_note_owned(meta_information_struct);
+	spinlock_unlock(&(meta_information_struct->lock));
+
+	DEBUG("Bloc %p (taille : %lu) obtenu depuis le cache du thread \n", meta_information_struct->data_ptr, meta_information_struct->size);
+	return (void*) meta_information_struct->data_ptr;
+}
+
+/**
+ * La fonction thread_cache_push() ajoute au cache du thread appelant un bloc occupé déjà nettoyé,
+ * dont le verrou est détenu par l'appelant. Elle renvoie 1 si le bloc a été ajouté au cache,
+ * ou 0 si le bloc doit être rendu au tas (cache désactivé, bloc trop grand ou case pleine).
+ */
+int	thread_cache_push(struct meta_information *meta_information_struct) {
+	size_t index = (meta_information_struct->size - 1) / THREAD_CACHE_GRANULARITY;
+	if (thread_cache_capacity == 0 || meta_information_struct->status != BUSY || meta_information_struct->size == 0 || index >= THREAD_CACHE_BUCKETS_NB
+			|| thread_cache.blocks_nb[index] >= thread_cache_capacity)
+		return 0;
+
+	// Activation du destructeur qui rendra les blocs du cache au tas à la fin du thread
+	if (!thread_cache.registered) {
+		// int pthread_setspecific(pthread_key_t key, const void *value);
+		int pthread_setspecific_result = pthread_setspecific(thread_cache_key, &thread_cache);
+		if (pthread_setspecific_result != 0)
+			handle_errnum("pthread_setspecific()", pthread_setspecific_result);
+		thread_cache.registered = 1;
+	}
+
+	meta_information_struct->status = CACHED;
+	meta_information_struct->next_free = thread_cache.buckets[index];
+	thread_cache.buckets[index] = meta_information_struct;
+	thread_cache.blocks_nb[index]++;
+
+	DEBUG("Bloc %p (taille : %lu) conserve dans le cache du thread \n", meta_information_struct->data_ptr, meta_information_struct->size);
+	return 1;
+}
+
+/**
+ * La fonction thread_cache_note_owned() note dans la table du thread appelant un bloc qu'il vient d'obtenir
+ * (et dont le verrou est détenu par l'appelant). Le bloc noté précédemment dans la même case est oublié.
+ */
+void	thread_cache_note_owned(struct meta_information *meta_information_struct) {
+	if (thread_cache_capacity == 0)
+		return;
+
+	size_t index = ((size_t) meta_information_struct->data_ptr / ALLOCATION_ALIGNMENT) % THREAD_CACHE_OWNED_NB;
+	thread_cache.owned[index] = meta_information_struct;
+}
+
+/**
+ * La fonction thread_cache_find_owned() renvoie, verrouillé, le bloc de métadonnées noté dans la table du thread
+ * appelant dont le bloc de données commence à l'adresse ptr, ou NULL (l'index des pointeurs doit alors être consulté).
+ * Un bloc noté a pu être libéré, fusionné ou réutilisé depuis : son statut est vérifié par l'appelant. Le pool
+ * de meta-information n'est jamais déplacé ni réduit, et le statut et l'adresse des données d'un bloc de
+ * métadonnées ne sont modifiés qu'en présence de son verrou.
+ */
+struct meta_information	*thread_cache_find_owned(void *ptr) {
+	if (thread_cache_capacity == 0)
+		return NULL;
+
+	struct meta_information *meta_information_struct = thread_cache.owned[((size_t) ptr / ALLOCATION_ALIGNMENT) % THREAD_CACHE_OWNED_NB];
+	if (meta_information_struct == NULL)
+		return NULL;
+
+	spinlock_lock(&(meta_information_struct->lock));
+	if (meta_information_struct->data_ptr != ptr) {
+		spinlock_unlock(&(meta_information_struct->lock));
+		return NULL;
+	}
+
+	return meta_information_struct;
+}
+
+/**
+ * La fonction thread_cache_flush() rend au tas tous les blocs du cache pointé par arg.
+ * Elle est appelée à la fin de chaque thread qui a utilisé son cache (destructeur de thread_cache_key).
+ */
+void	thread_cache_flush(void *arg) {
+	struct thread_cache *thread_cache_ptr = (struct thread_cache *) arg;
+
+	for (size_t i = 0; i < THREAD_CACHE_BUCKETS_NB; i++) {
+		while (thread_cache_ptr->buckets[i] != NULL) {
+			struct meta_information *meta_information_struct = thread_cache_ptr->buckets[i];
+			thread_cache_ptr->buckets[i] = meta_information_struct->next_free;
+
+			spinlock_lock(&(meta_information_struct->lock));
+			meta_information_struct->next_free = NULL;
+			release_chunck(meta_information_struct);
+		}
+		thread_cache_ptr->blocks_nb[i] = 0;
+	}
+
+	thread_cache_ptr->registered = 0;
+}
@@ -8,8 +8,9 @@
 #include <dlfcn.h> // dlsym()
 #include <sys/types.h> // kill(), SIGUSR1
 #include <signal.h> // kill(), SIGUSR1
-#include <unistd.h> // getpid()
-#include <pthread.h> // PTHREAD_ONCE_INIT
+#include <unistd.h> // getpid(), sysconf()
+#include <pthread.h> // PTHREAD_ONCE_INIT, pthread_create(), pthread_join()
+#include <errno.h> // errno, ENOMEM
 #include "auxiliary_functions.private.h"
 #include "basic_operations.private.h"
 
@@ -19,14 +20,47 @@
 
 size_t page_size = 0;
 int logs_file_descriptor = -1;
+int log_level = LOG_LEVEL_TRACE; // Jusqu'à l'initialisation du journal, les messages sont filtrés par log_message()
+struct log_flusher log_flusher;
+__thread struct log_ring *thread_log_ring __attribute__((tls_model("initial-exec"))) = NULL;
+int trace_enabled = 0;
+uint32_t trace_threads_nb = 0;
+__thread uint32_t trace_thread_id __attribute__((tls_model("initial-exec"))) = 0;
 
-struct struct_canary *data_pool = NULL;
-struct meta_information *meta_information_pool_root = NULL;
+struct arena arenas[ARENAS_MAX_NB];
+size_t arenas_nb = 0;
+size_t next_arena_index = 0; // Indice (modulo arenas_nb) de l'arène du prochain thread
+__thread struct arena *thread_arena __attribute__((tls_model("initial-exec"))) = NULL;
 
-size_t data_pool_size = 0;
-size_t meta_information_pool_size = 0;
+struct pointer_index pointer_index;
+
+size_t thread_cache_capacity = 0; // Nombre maximal de blocs par case du cache d'un thread (0 : cache désactivé)
+pthread_key_t thread_cache_key;
+__thread struct thread_cache thread_cache __attribute__((tls_model("initial-exec")));
+
+struct thread_stats *thread_stats_list = NULL;
+pthread_key_t thread_stats_key;
+__thread struct thread_stats *thread_stats __attribute__((tls_model("initial-exec"))) = NULL;
+int stats_signal = 0;
+int stats_dump_requested = 0;
+
+size_t mmap_threshold = MMAP_THRESHOLD_DEFAULT; // Taille au-delà de laquelle une allocation dispose de son propre mappage
+int huge_pages_enabled = 0; // Pools de data soutenus par des pages de grande taille (MSM_HUGE_PAGES)
+
+int slabs_enabled = 0; // Petites allocations placées dans des slabs (MSM_SLABS)
+struct slab_pool slab_pool;
+
+size_t guard_sample_rate = 0; // Une allocation sur guard_sample_rate est placée contre une page de garde (0 : échantillonnage désactivé)
+__thread size_t guard_sample_counter __attribute__((tls_model("initial-exec"))) = 0;
+struct guard_pool guard_pool;
+
+size_t deferred_wipe_min_size = 0; // Taille minimale des blocs dont le nettoyage est différé (0 : nettoyage différé désactivé)
+struct wipe_queue wipe_queue;
 
 int dynamic_overflow_detection_activated;
+size_t scan_batch_size = SCAN_BATCH_SIZE_DEFAULT; // Nombre maximal de blocs de métadonnées vérifiés par passage du thread de parcours du tas
+size_t scan_time_budget = SCAN_TIME_BUDGET_DEFAULT; // Durée maximale d'un passage (en microsecondes)
+size_t scan_interval = SCAN_INTERVAL_DEFAULT; // Intervalle entre deux passages (en millisecondes)
 pthread_once_t already_initialized = PTHREAD_ONCE_INIT;
 pthread_mutex_t dynamic_overflow_detection_activated_mutex;
 
@@ -40,7 +74,7 @@ pthread_mutex_t dynamic_overflow_detection_activated_mutex;
  * ou NULL en cas d'erreur. La mémoire n'est pas initialisée.
  */
 void    *my_malloc(size_t size) {
-	LOG("my_malloc(%lu) \n", size);
+	DEBUG("my_malloc(%lu) \n", size);
 	pthread_init_once();
 
     // Si la taille est 0, alors my_malloc() renvoie NULL
@@ -57,7 +91,7 @@ void    *my_malloc(size_t size) {
  * La fonction my_free() ne renvoie aucune valeur.
  */
 void    my_free(void *ptr) {
-	LOG("my_free(%p) \n", ptr);
+	DEBUG("my_free(%p) \n", ptr);
 	pthread_init_once();
 
     // Si ptr est NULL, aucune opération n’est effectuée.
@@ -65,6 +99,8 @@ void    my_free(void *ptr) {
 		return;
 
 	int clean_result = clean(ptr);
+	if (clean_result != 0)
+		stats_count(STATS_FREES, 0);
 
 	// Si l'espace mémoire pointé par ptr, n'a pas été renvoyé par un appel précédent
     // à my_malloc(), my_calloc() ou my_realloc(), ou si free(ptr) a déjà été appelé auparavant
@@ -81,21 +117,33 @@ void    my_free(void *ptr) {
  * renvoie un pointeur vers la mémoire allouée ou NULL en cas d'erreur. La mémoire est mise à zéro.
  */
 void    *my_calloc(size_t nmemb, size_t size) {
-	LOG("my_calloc(%lu, %lu) \n", nmemb, size);
+	DEBUG("my_calloc(%lu, %lu) \n", nmemb, size);
 	pthread_init_once();
+	stats_count(STATS_CALLOC_CALLS, 0);
 
     // Si nmemb ou size est 0, alors my_calloc() renvoie NULL
 	if (nmemb == 0 || size == 0)
 		return NULL;
 
-	void *my_malloc_result = my_malloc(nmemb * size);
-	if (my_malloc_result != NULL) {
-		// La mémoire est mise à zéro.
+	// Si la multiplication nmemb * size dépasse la valeur maximale d'un size_t, my_calloc() renvoie NULL
+	size_t total_size;
+	if (__builtin_mul_overflow(nmemb, size, &total_size)) {
+		LOG_ERROR("my_calloc(%lu, %lu) : la taille demandee depasse la valeur maximale d'un size_t \n", nmemb, size);
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	int zeroed;
+	void *alloc_result = alloc_and_get_zeroed(total_size, &zeroed);
+
+	// La mémoire est mise à zéro, sauf si elle ne contient déjà que des zéros
+	// (mémoire nouvellement mappée, ou bloc nettoyé lors de sa libération)
+	if (alloc_result != NULL && !zeroed) {
 		// void * memset(void * block, int value, size_t size);
-		memset(my_malloc_result, 0, nmemb * size);
+		memset(alloc_result, 0, total_size);
 	}
 
-	return my_malloc_result;
+	return alloc_result;
 }
 
 /**
@@ -113,8 +161,9 @@ void    *my_calloc(size_t nmemb, size_t size) {
  * Si my_realloc() échoue, le bloc d'origine reste intact ; il n'est ni libéré ni déplacé.
  */
 void    *my_realloc(void *ptr, size_t size) {
-	LOG("my_realloc(%lx, %lu) \n", (size_t) ptr, size);
+	DEBUG("my_realloc(%lx, %lu) \n", (size_t) ptr, size);
 	pthread_init_once();
+	stats_count(STATS_REALLOC_CALLS, 0);
 
     // Si ptr est NULL, alors l'appel est équivalent à my_malloc(size),
 	// pour toutes les valeurs de size
@@ -131,10 +180,49 @@ void    *my_realloc(void *ptr, size_t size) {
     	return NULL;
     }
 
+	// Un emplacement de slab est conservé tant que la nouvelle taille y tient, sinon l'allocation est déplacée
+	if (is_in_slab_pool(ptr)) {
+		size_t slot_size = get_slab_slot_size(ptr);
+		if (slot_size == 0) {
+			LOG_ERROR("my_realloc(%p, %lu) : un pointeur qui ne provient pas d'un appel précédent à my_malloc(), "
+					"my_calloc() ou my_realloc() \n", ptr, size);
+			kill(getpid(), SIGUSR1);
+			return NULL;
+		}
+
+		if (size <= slot_size)
+			return ptr;
+
+		void *new_ptr = alloc(size);
+		if (new_ptr == NULL)
+			return NULL;
+
+		memcpy(new_ptr, ptr, slot_size);
+		my_free(ptr);
+		return new_ptr;
+	}
+
+	// La taille d'un bloc du pool de data est arrondie comme lors de son allocation
+	if (size <= mmap_threshold) {
+		if (size > ALIGN_SIZE_MAX) {
+			errno = ENOMEM;
+			return NULL;
+		}
+		size = ALIGN_SIZE(size);
+	}
+
     // À moins que ptr soit NULL, il doit avoir été renvoyé par un appel antérieur
     // à my_malloc(), my_calloc() ou my_realloc().
-	struct meta_information *metadata_of_ptr = metadata_linked_list_map(meta_information_pool_root, 1,
-			is_meta_information_of_memory_ptr, ptr, 0);
+	struct meta_information *metadata_of_ptr = pointer_index_find(ptr);
+	if (metadata_of_ptr != NULL) {
+		spinlock_lock(&(metadata_of_ptr->lock));
+		if ((metadata_of_ptr->status != BUSY && metadata_of_ptr->status != MAPPED && metadata_of_ptr->status != GUARDED)
+				|| metadata_of_ptr->data_ptr != ptr) {
+			spinlock_unlock(&(metadata_of_ptr->lock));
+			metadata_of_ptr = NULL;
+		}
+	}
+
 	if (metadata_of_ptr == NULL) {
 		LOG_ERROR("my_realloc(%p, %lu) : un pointeur qui ne provient pas d'un appel précédent à my_malloc(), "
 				"my_calloc() ou my_realloc() \n", ptr, size);
@@ -147,18 +235,30 @@ void    *my_realloc(void *ptr, size_t size) {
 
 	// Si la taille reste inchangée
 	if (metadata_of_ptr->size == size) {
-		mutex_unlock(&(metadata_of_ptr->mutex));
+		spinlock_unlock(&(metadata_of_ptr->lock));
 		return ptr;
 	}
 
+	// Une grande allocation qui reste au-delà du seuil est redimensionnée sans copie : sur place si son mappage
+	// contient le même nombre de pages, sinon avec mremap(). Si elle passe sous le seuil, elle est déplacée
+	// (une grande allocation n'a pas de voisins)
+	if (metadata_of_ptr->status == MAPPED) {
+		if (size > mmap_threshold) {
+			void *resized_ptr = resize_mapped_chunck(metadata_of_ptr, size);
+			if (resized_ptr != NULL)
+				add_recent_block(metadata_of_ptr);
+
+			spinlock_unlock(&(metadata_of_ptr->lock));
+			return resized_ptr;
+		}
+	}
 	// Si la taille demandée est inférieure à la taille actuelle
-	if (size < metadata_of_ptr->size) {
+	// (une allocation échantillonnée doit rester contre sa page de garde : elle est toujours déplacée)
+	else if (metadata_of_ptr->status != GUARDED && size < metadata_of_ptr->size) {
 
-		if (memory_division(metadata_of_ptr, size) && metadata_of_ptr->next != NULL) {
-			clean(metadata_of_ptr->next->data_ptr);
-
-		} else if (metadata_of_ptr->next != NULL) {
-			mutex_lock(&(metadata_of_ptr->next->mutex));
+		// Si une division est effectuée, le nouveau bloc libre est fusionné avec le bloc suivant s'il est libre
+		if (!memory_division(metadata_of_ptr, size) && metadata_of_ptr->next != NULL) {
+			spinlock_lock(&(metadata_of_ptr->next->lock));
 
 			if (metadata_of_ptr->next->status == FREE) {
 				size_t diff = metadata_of_ptr->size - size;
@@ -167,129 +267,478 @@ void    *my_realloc(void *ptr, size_t size) {
 				chunck->canary = get_canary();
 
 				metadata_of_ptr->size -= diff;
+
+				// Le bloc suivant change de taille, et donc potentiellement de classe de taille
+				free_list_remove(metadata_of_ptr->next);
 				metadata_of_ptr->next->size += diff;
+				metadata_of_ptr->next->zeroed = 0;
+				free_list_insert(metadata_of_ptr->next);
 				metadata_of_ptr->next->data_ptr = (struct struct_canary *) (((size_t) metadata_of_ptr->next->data_ptr) - diff);
-				LOG("metadata_of_ptr->next->data_ptr %p \n", metadata_of_ptr->next->data_ptr);
+				DEBUG("metadata_of_ptr->next->data_ptr %p \n", metadata_of_ptr->next->data_ptr);
 			}
-			mutex_unlock(&(metadata_of_ptr->next->mutex));
+			spinlock_unlock(&(metadata_of_ptr->next->lock));
 		}
 
-		mutex_unlock(&(metadata_of_ptr->mutex));
+		add_recent_block(metadata_of_ptr);
+		spinlock_unlock(&(metadata_of_ptr->lock));
 		return ptr;
 	}
 
 	/* Si la taille demandée est supérieure à la taille actuelle */
 
-	// Si ce n'est pas le dernier bloc
+	// Si ce n'est pas le dernier bloc (une grande allocation n'a pas de bloc suivant)
 	if (metadata_of_ptr->next != NULL) {
-
-		mutex_lock(&(metadata_of_ptr->next->mutex));
 		struct meta_information *next_meta_information_struct = metadata_of_ptr->next;
-		struct meta_information *next_next_meta_information_struct = next_meta_information_struct->next;
+		spinlock_lock(&(next_meta_information_struct->lock));
 
-		if (next_next_meta_information_struct != NULL)
-			mutex_lock(&(next_next_meta_information_struct->mutex));
-
-		if (metadata_of_ptr->next->status == FREE
-			&& (metadata_of_ptr->size + sizeof(struct struct_canary) + metadata_of_ptr->next->size) >= size) {
-
-			// Puisque nous fusionnons des espaces mémoire, le bloc de métadonnées suivant n'est plus nécessaire
-			metadata_of_ptr->next->status = UNUSED;
-			metadata_of_ptr->next->size = 0;
-			metadata_of_ptr->next->data_ptr = NULL;
-			metadata_of_ptr->next->next = NULL;
-			metadata_of_ptr->next->prev = NULL;
-
-			struct struct_canary *chunck = (struct struct_canary *) ((size_t) metadata_of_ptr->data_ptr + metadata_of_ptr->size + sizeof(struct struct_canary) + next_meta_information_struct->size);
-			chunck->canary = get_canary();
+		if (next_meta_information_struct->status == FREE
+			&& (metadata_of_ptr->size + sizeof(struct struct_canary) + next_meta_information_struct->size) >= size) {
 
 			// Effectuer une fusion avec l'espace mémoire pointé par le prochain bloc de métadonnées
-			metadata_of_ptr->size += sizeof(struct struct_canary) + next_meta_information_struct->size;
-			// Le bloc suivant est maintenant le bloc suivant du bloc suivant
-			metadata_of_ptr->next = next_next_meta_information_struct;
-			// Le bloc précédent du bloc suivant du bloc suivant est maintenant ce bloc
-			if (next_next_meta_information_struct != NULL)
-				next_next_meta_information_struct->prev = metadata_of_ptr;
+			// (puisque nous fusionnons des espaces mémoire, le bloc de métadonnées suivant n'est plus nécessaire)
+			free_list_remove(next_meta_information_struct);
+			absorb_next_chunck(metadata_of_ptr, next_meta_information_struct);
 
 			memory_division(metadata_of_ptr, size);
-			if (next_next_meta_information_struct != NULL) {
-				mutex_unlock(&(next_next_meta_information_struct->mutex));
-			}
-
-			mutex_unlock(&(next_meta_information_struct->mutex));
-			mutex_unlock(&(metadata_of_ptr->mutex));
+			add_recent_block(metadata_of_ptr);
+			spinlock_unlock(&(metadata_of_ptr->lock));
 			return ptr;
 		}
 
-		if (next_next_meta_information_struct != NULL) {
-			mutex_unlock(&(next_next_meta_information_struct->mutex));
-		}
+		// Si le bloc suivant est libre mais trop petit, et qu'il s'agit du dernier bloc de l'arène, le bloc est
+		// fusionné avec lui puis le pool de data (qui n'est jamais déplacé) est élargi sur place, sans copie
+		if (next_meta_information_struct->status == FREE && next_meta_information_struct->next == NULL && size <= mmap_threshold) {
+			free_list_remove(next_meta_information_struct);
+			absorb_next_chunck(metadata_of_ptr, next_meta_information_struct);
 
-		mutex_unlock(&(next_meta_information_struct->mutex));
-	}
+			size_t delta_size = get_delta_size(size - metadata_of_ptr->size + sizeof(struct struct_canary));
+			extend_data_pool(metadata_of_ptr, delta_size);
 
-	mutex_unlock(&(metadata_of_ptr->mutex));
-	struct meta_information *ptr_meta_information =
-			metadata_linked_list_map(meta_information_pool_root, 1, is_meta_information_of_memory_ptr, ptr, 0);
-	if (ptr_meta_information == NULL) {
-		return NULL;
+			memory_division(metadata_of_ptr, size);
+			add_recent_block(metadata_of_ptr);
+			spinlock_unlock(&(metadata_of_ptr->lock));
+			return ptr;
+		}
+
+		spinlock_unlock(&(next_meta_information_struct->lock));
 	}
 
-	size_t prev_size = ptr_meta_information->size;
+	size_t prev_size = metadata_of_ptr->size;
+	spinlock_unlock(&(metadata_of_ptr->lock));
 
 	void *new_ptr = alloc(size);
+	if (new_ptr == NULL)
+		return NULL;
+
 	// void * memcpy (void *restrict to, const void *restrict from, size_t size)
-	memcpy(new_ptr, ptr ,prev_size);
+	memcpy(new_ptr, ptr, (prev_size < size) ? prev_size : size);
 
 	// Si la zone pointée a été déplacée, un my_free(ptr) est effectué.
 	my_free(ptr);
 
-	mutex_unlock(&(ptr_meta_information->mutex));
 	return new_ptr;
 }
 
+/* ****************************************************************** */
+/* ******************* ALLOCATIONS ALIGNÉES ************************* */
+/* ****************************************************************** */
+
+/**
+ * int     my_posix_memalign(void **memptr, size_t alignment, size_t size)
+ * La fonction my_posix_memalign() alloue size octets et place l'adresse de la mémoire allouée dans *memptr.
+ * L'adresse de la mémoire allouée est un multiple de alignment, qui doit être une puissance de 2 et un multiple
+ * de sizeof(void *). La fonction renvoie 0 en cas de succès, EINVAL si alignment n'est pas valide,
+ * ou ENOMEM s'il n'y a pas assez de mémoire (la valeur de errno n'est pas modifiée).
+ */
+int     my_posix_memalign(void **memptr, size_t alignment, size_t size) {
+	DEBUG("my_posix_memalign(%p, %lu, %lu) \n", memptr, alignment, size);
+	pthread_init_once();
+
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment % sizeof(void *) != 0)
+		return EINVAL;
+
+	// Si size est 0, *memptr reçoit NULL (comme my_malloc(0))
+	*memptr = NULL;
+	if (size == 0)
+		return 0;
+
+	int saved_errno = errno;
+	*memptr = alloc_aligned(alignment, size);
+	errno = saved_errno;
+	return (*memptr == NULL) ? ENOMEM : 0;
+}
+
+/**
+ * void    *my_aligned_alloc(size_t alignment, size_t size)
+ * La fonction my_aligned_alloc() alloue size octets dont l'adresse est un multiple de alignment, qui doit être
+ * une puissance de 2. Elle renvoie un pointeur vers la mémoire allouée, ou NULL en cas d'erreur (errno vaut alors
+ * EINVAL si alignment n'est pas valide, ou ENOMEM).
+ */
+void    *my_aligned_alloc(size_t alignment, size_t size) {
+	DEBUG("my_aligned_alloc(%lu, %lu) \n", alignment, size);
+	pthread_init_once();
+
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (size == 0)
+		return NULL;
+
+	void *ptr = alloc_aligned(alignment, size);
+	if (ptr == NULL)
+		errno = ENOMEM;
+	return ptr;
+}
+
+/**
+ * void    *my_memalign(size_t alignment, size_t size)
+ * La fonction obsolète my_memalign() est équivalente à my_aligned_alloc(), mais un alignement qui n'est pas
+ * une puissance de 2 est arrondi à la puissance de 2 supérieure (comme memalign() de la glibc).
+ */
+void    *my_memalign(size_t alignment, size_t size) {
+	DEBUG("my_memalign(%lu, %lu) \n", alignment, size);
+
+	size_t rounded_alignment = 1;
+	while (rounded_alignment < alignment) {
+		rounded_alignment <<= 1;
+		if (rounded_alignment == 0) {
+			errno = EINVAL;
+			return NULL;
+		}
+	}
+
+	return my_aligned_alloc(rounded_alignment, size);
+}
+
+/**
+ * void    *my_valloc(size_t size)
+ * La fonction obsolète my_valloc() alloue size octets dont l'adresse est un multiple de la taille d'une page.
+ */
+void    *my_valloc(size_t size) {
+	pthread_init_once();
+	return my_aligned_alloc(page_size, size);
+}
+
+/**
+ * void    *my_pvalloc(size_t size)
+ * La fonction obsolète my_pvalloc() est équivalente à my_valloc(), mais size est arrondi au multiple
+ * de la taille d'une page supérieur (une page est allouée si size est 0).
+ */
+void    *my_pvalloc(size_t size) {
+	pthread_init_once();
+
+	size_t rounded_size = (size == 0) ? page_size : (size + page_size - 1) & ~(page_size - 1);
+	if (rounded_size < size) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	return my_aligned_alloc(page_size, rounded_size);
+}
+
+/**
+ * void    *my_reallocarray(void *ptr, size_t nmemb, size_t size)
+ * La fonction my_reallocarray() modifie la taille du bloc mémoire pointé par ptr pour qu'il contienne un tableau
+ * de nmemb éléments de size octets chacun, comme my_realloc(ptr, nmemb * size). Si la multiplication dépasse
+ * la valeur maximale d'un size_t, elle renvoie NULL (errno vaut ENOMEM) et le bloc d'origine reste intact.
+ */
+void    *my_reallocarray(void *ptr, size_t nmemb, size_t size) {
+	DEBUG("my_reallocarray(%p, %lu, %lu) \n", ptr, nmemb, size);
+
+	size_t total_size;
+	if (__builtin_mul_overflow(nmemb, size, &total_size)) {
+		LOG_ERROR("my_reallocarray(%p, %lu, %lu) : la taille demandee depasse la valeur maximale d'un size_t \n", ptr, nmemb, size);
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	return my_realloc(ptr, total_size);
+}
+
+/**
+ * size_t  my_malloc_usable_size(void *ptr)
+ * La fonction my_malloc_usable_size() renvoie le nombre d'octets utilisables du bloc pointé par ptr, qui doit
+ * avoir été renvoyé par une fonction d'allocation, ou 0 si ptr est NULL ou ne pointe pas vers un bloc occupé.
+ * Les octets qui suivent ne sont pas utilisables : le canari du bloc y est placé.
+ */
+size_t  my_malloc_usable_size(void *ptr) {
+	pthread_init_once();
+	if (ptr == NULL)
+		return 0;
+
+	if (is_in_slab_pool(ptr))
+		return get_slab_slot_size(ptr);
+
+	size_t usable_size = 0;
+	struct meta_information *metadata_of_ptr = pointer_index_find(ptr);
+	if (metadata_of_ptr != NULL) {
+		spinlock_lock(&(metadata_of_ptr->lock));
+		if ((metadata_of_ptr->status == BUSY || metadata_of_ptr->status == MAPPED || metadata_of_ptr->status == GUARDED)
+				&& metadata_of_ptr->data_ptr == ptr)
+			usable_size = metadata_of_ptr->size;
+		spinlock_unlock(&(metadata_of_ptr->lock));
+	}
+
+	return usable_size;
+}
+
+/* ****************************************************************** */
+/* ************************ MAINTENANCE DU TAS ********************** */
+/* ****************************************************************** */
+
+/**
+ * void    secmalloc_coalesce()
+ * La fonction secmalloc_coalesce() parcourt le tas de chaque arène et fusionne tous les blocs libres consécutifs.
+ * Lors d'une libération, seuls les voisins immédiats du bloc libéré sont fusionnés ; ce parcours complet
+ * (qui verrouille les blocs les uns après les autres) n'est effectué que sur demande.
+ */
+void    secmalloc_coalesce() {
+	LOG("secmalloc_coalesce() \n");
+	pthread_init_once();
+
+	for (size_t i = 0; i < arenas_nb; i++) {
+		if (__atomic_load_n(&(arenas[i].initialized), __ATOMIC_ACQUIRE))
+			metadata_linked_list_map(arenas[i].meta_information_pool_root, 0, merge_if_free, NULL, 1);
+	}
+}
+
+/**
+ * size_t  secmalloc_check()
+ * La fonction secmalloc_check() vérifie l'intégrité du tas de chaque arène : le canari de chaque bloc
+ * et la cohérence de la liste chaînée des blocs de métadonnées. Le travail est partagé entre le thread
+ * appelant et au plus HEAP_CHECK_WORKERS_MAX - 1 threads supplémentaires (un par processeur disponible).
+ * La fonction renvoie le nombre d'incohérences détectées (0 si le tas est intact).
+ */
+size_t  secmalloc_check() {
+	LOG("secmalloc_check() \n");
+	pthread_init_once();
+
+	long processors_nb = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t workers_nb = (processors_nb < 1) ? 1 : (size_t) processors_nb;
+	if (workers_nb > HEAP_CHECK_WORKERS_MAX)
+		workers_nb = HEAP_CHECK_WORKERS_MAX;
+
+	struct heap_check_worker workers[HEAP_CHECK_WORKERS_MAX];
+	pthread_t threads_id[HEAP_CHECK_WORKERS_MAX];
+
+	for (size_t i = 0; i < workers_nb; i++) {
+		workers[i].index = i;
+		workers[i].workers_nb = workers_nb;
+		workers[i].errors_nb = 0;
+	}
+
+	// int pthread_create(pthread_t *thread, const pthread_attr_t *attr, void *(*start_routine) (void *), void *arg);
+	for (size_t i = 1; i < workers_nb; i++) {
+		int pthread_create_result = pthread_create(&threads_id[i], NULL, heap_check, &workers[i]);
+		if (pthread_create_result != 0)
+			handle_errnum("pthread_create()", pthread_create_result);
+	}
+
+	// La première tranche est vérifiée par le thread appelant
+	heap_check(&workers[0]);
+
+	size_t errors_nb = workers[0].errors_nb;
+	for (size_t i = 1; i < workers_nb; i++) {
+		// int pthread_join(pthread_t thread, void **retval);
+		int pthread_join_result = pthread_join(threads_id[i], NULL);
+		if (pthread_join_result != 0)
+			handle_errnum("pthread_join()", pthread_join_result);
+
+		errors_nb += workers[i].errors_nb;
+	}
+
+	LOG("secmalloc_check() : %lu incoherence(s) detectee(s) \n", errors_nb);
+	return errors_nb;
+}
+
+/**
+ * size_t  secmalloc_trim()
+ * La fonction secmalloc_trim() rend au système la mémoire libre du tas de chaque arène : le pool de data est réduit
+ * si son dernier bloc est libre, et les pages entièrement contenues dans un bloc libre sont libérées avec
+ * madvise(MADV_DONTNEED). Les blocs dont le verrou est détenu par un autre thread sont ignorés.
+ * La fonction renvoie le nombre d'octets rendus au système.
+ */
+size_t  secmalloc_trim() {
+	LOG("secmalloc_trim() \n");
+	pthread_init_once();
+
+	size_t released_size = 0;
+	for (size_t i = 0; i < arenas_nb; i++) {
+		if (!__atomic_load_n(&(arenas[i].initialized), __ATOMIC_ACQUIRE))
+			continue;
+
+		released_size += trim_data_pool(&arenas[i]);
+		metadata_array_map(&arenas[i], 0, release_free_pages, &released_size, 0, 0);
+	}
+
+	released_size += release_empty_slabs();
+
+	LOG("secmalloc_trim() : %lu octets rendus au systeme \n", released_size);
+	return released_size;
+}
+
+/**
+ * void    secmalloc_stats(struct secmalloc_stats *stats)
+ * La fonction secmalloc_stats() remplit stats avec l'état du tas de chaque arène (mémoire mappée, octets occupés
+ * et libres, plus grand bloc libre, nombre de blocs) et la somme des compteurs de tous les threads.
+ * Les blocs dont le verrou est détenu par un autre thread ne sont pas comptés : pendant que d'autres threads
+ * allouent, les statistiques sont approximatives.
+ */
+void    secmalloc_stats(struct secmalloc_stats *stats) {
+	LOG("secmalloc_stats() \n");
+	pthread_init_once();
+
+	memset(stats, 0, sizeof(struct secmalloc_stats));
+
+	for (size_t i = 0; i < arenas_nb; i++) {
+		if (!__atomic_load_n(&(arenas[i].initialized), __ATOMIC_ACQUIRE))
+			continue;
+
+		stats->metadata_bytes += arenas[i].meta_information_pool_committed_size + arenas[i].unused_bitmap_size;
+		stats->mapped_bytes += arenas[i].data_pool_committed_size;
+		metadata_array_map(&arenas[i], 0, add_block_stats, stats, 0, 0);
+	}
+
+	size_t slabs_nb = slabs_enabled ? __atomic_load_n(&(slab_pool.slabs_nb), __ATOMIC_ACQUIRE) : 0;
+	for (size_t i = 0; i < slabs_nb; i++) {
+		struct slab_class *slab_class = lock_slab_class(&(slab_pool.descriptors[i]), 0);
+		if (slab_class == NULL)
+			continue;
+
+		stats->slab_slots_nb += slab_pool.descriptors[i].used_slots_nb;
+		stats->live_bytes += slab_pool.descriptors[i].used_slots_nb * (slab_pool.descriptors[i].slot_size - SLAB_CANARY_SIZE);
+		stats->free_bytes += (size_t) (slab_pool.descriptors[i].slots_nb - slab_pool.descriptors[i].used_slots_nb)
+				* (slab_pool.descriptors[i].slot_size - SLAB_CANARY_SIZE);
+		mutex_unlock(&(slab_class->mutex));
+	}
+
+	stats->slab_bytes = slabs_nb * SLAB_SIZE;
+	stats->mapped_bytes += stats->slab_bytes;
+	stats->metadata_bytes += slabs_nb * sizeof(struct slab);
+	stats->huge_page_bytes = get_huge_page_bytes();
+	stats->metadata_bytes += pointer_index.buckets_nb * sizeof(struct meta_information *);
+	stats->mapped_bytes += stats->metadata_bytes;
+
+	struct thread_stats *thread_stats_element = __atomic_load_n(&thread_stats_list, __ATOMIC_ACQUIRE);
+	for (; thread_stats_element != NULL; thread_stats_element = thread_stats_element->next) {
+		stats->allocations_nb += __atomic_load_n(&(thread_stats_element->counters[STATS_ALLOCATIONS]), __ATOMIC_RELAXED);
+		stats->frees_nb += __atomic_load_n(&(thread_stats_element->counters[STATS_FREES]), __ATOMIC_RELAXED);
+		stats->calloc_calls_nb += __atomic_load_n(&(thread_stats_element->counters[STATS_CALLOC_CALLS]), __ATOMIC_RELAXED);
+		stats->realloc_calls_nb += __atomic_load_n(&(thread_stats_element->counters[STATS_REALLOC_CALLS]), __ATOMIC_RELAXED);
+
+		for (size_t i = 0; i < SECMALLOC_SIZE_CLASSES_NB; i++)
+			stats->size_classes[i] += __atomic_load_n(&(thread_stats_element->size_classes[i]), __ATOMIC_RELAXED);
+	}
+
+	DEBUG("secmalloc_stats() : %lu octets occupes, %lu octets libres \n", stats->live_bytes, stats->free_bytes);
+}
+
 #ifdef DYNAMIC
 void    *malloc(size_t size) {
 	/*
-	LOG("Avant le vrai malloc %ld\n", size);
+	DEBUG("Avant le vrai malloc %ld\n", size);
 	void *(*real_malloc)(size_t) = dlsym(RTLD_NEXT, "malloc");
-	LOG("Après le vrai malloc %p\n", real_malloc);
+	DEBUG("Après le vrai malloc %p\n", real_malloc);
     return real_malloc(size);
 	*/
 
-    return my_malloc(size);
+	void *ptr = my_malloc(size);
+	if (trace_enabled)
+		trace_operation(TRACE_MALLOC, NULL, 0, size, ptr, get_timestamp());
+	return ptr;
 }
 void    free(void *ptr) {
 	/*
-	LOG("Avant le vrai free %p\n", ptr);
+	DEBUG("Avant le vrai free %p\n", ptr);
 	void (*real_free)(void *) = dlsym(RTLD_NEXT, "free");
-	LOG("Après le vrai free %p\n", real_free);
+	DEBUG("Après le vrai free %p\n", real_free);
 	real_free(ptr);
 	return;
 	*/
 
+	if (trace_enabled)
+		trace_operation(TRACE_FREE, ptr, 0, 0, NULL, get_timestamp());
 	my_free(ptr);
 }
 void    *calloc(size_t nmemb, size_t size) {
 	/*
-	LOG("Avant le vrai calloc %ld %ld\n", nmemb, size);
+	DEBUG("Avant le vrai calloc %ld %ld\n", nmemb, size);
 	void *(*real_calloc)(size_t, size_t) = dlsym(RTLD_NEXT, "calloc");
-	LOG("Après le vrai calloc %p\n", real_calloc);
+	DEBUG("Après le vrai calloc %p\n", real_calloc);
     return real_calloc(nmemb, size);
 	*/
 
-    return my_calloc(nmemb, size);
+	void *ptr = my_calloc(nmemb, size);
+	if (trace_enabled)
+		trace_operation(TRACE_CALLOC, NULL, nmemb, size, ptr, get_timestamp());
+	return ptr;
 }
 
 void    *realloc(void *ptr, size_t size) {
 	/*
-	LOG("Avant le vrai realloc %p %ld\n", ptr, size);
+	DEBUG("Avant le vrai realloc %p %ld\n", ptr, size);
 	void *(*real_realloc)(void *, size_t) = dlsym(RTLD_NEXT, "realloc");
-	LOG("Après le vrai realloc %p\n", real_realloc);
+	DEBUG("Après le vrai realloc %p\n", real_realloc);
     return real_realloc(ptr, size);
 	*/
 
-    return my_realloc(ptr, size);
+	// realloc() libère ptr et alloue un nouveau bloc : la date est prise avant l'appel, comme pour free()
+	uint64_t timestamp = trace_enabled ? get_timestamp() : 0;
+	void *new_ptr = my_realloc(ptr, size);
+	if (trace_enabled)
+		trace_operation(TRACE_REALLOC, ptr, 0, size, new_ptr, timestamp);
+	return new_ptr;
+}
+
+// Les fonctions d'allocation alignée de la glibc sont elles aussi remplacées : sinon, les blocs qu'elles allouent
+// proviendraient du tas de la glibc, et seraient ensuite passés à free() (et donc à my_free())
+int     posix_memalign(void **memptr, size_t alignment, size_t size) {
+	int result = my_posix_memalign(memptr, alignment, size);
+	if (trace_enabled && result == 0)
+		trace_operation(TRACE_MEMALIGN, NULL, alignment, size, *memptr, get_timestamp());
+	return result;
+}
+
+void    *aligned_alloc(size_t alignment, size_t size) {
+	void *ptr = my_aligned_alloc(alignment, size);
+	if (trace_enabled)
+		trace_operation(TRACE_MEMALIGN, NULL, alignment, size, ptr, get_timestamp());
+	return ptr;
+}
+
+void    *memalign(size_t alignment, size_t size) {
+	void *ptr = my_memalign(alignment, size);
+	if (trace_enabled)
+		trace_operation(TRACE_MEMALIGN, NULL, alignment, size, ptr, get_timestamp());
+	return ptr;
+}
+
+void    *valloc(size_t size) {
+	void *ptr = my_valloc(size);
+	if (trace_enabled)
+		trace_operation(TRACE_MEMALIGN, NULL, page_size, size, ptr, get_timestamp());
+	return ptr;
+}
+
+void    *pvalloc(size_t size) {
+	void *ptr = my_pvalloc(size);
+	if (trace_enabled)
+		trace_operation(TRACE_MEMALIGN, NULL, page_size, size, ptr, get_timestamp());
+	return ptr;
+}
+
+void    *reallocarray(void *ptr, size_t nmemb, size_t size) {
+	uint64_t timestamp = trace_enabled ? get_timestamp() : 0;
+	void *new_ptr = my_reallocarray(ptr, nmemb, size);
+	if (trace_enabled && (new_ptr != NULL || nmemb == 0 || size == 0))
+		trace_operation(TRACE_REALLOC, ptr, 0, nmemb * size, new_ptr, timestamp);
+	return new_ptr;
+}
+
+size_t  malloc_usable_size(void *ptr) {
+	return my_malloc_usable_size(ptr);
 }
 
 #endif
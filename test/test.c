@@ -1,22 +1,29 @@
 #include <criterion/criterion.h>
-#include <unistd.h> // sleep()
+#include <stdlib.h> // setenv()
+#include <string.h> // memset()
+#include <unistd.h> // sleep(), fork(), execve(), alarm()
+#include <sys/wait.h> // waitpid()
 #include <pthread.h> // pthread_create(), pthread_exit(), pthread_join()
 #include <sys/types.h> // SIGUSR1
 #include <signal.h> // SIGUSR1
 #include "my_secmalloc.private.h"
 #include <sys/mman.h>
+#include <fcntl.h> // open()
+#include <errno.h> // errno, EINVAL, ENOMEM
 #include "auxiliary_functions.private.h"
+#include "basic_operations.private.h" // is_in_slab_pool()
 
 /* ****************************************************************** */
 /* ******* PROPRIÉTÉS QU'UNE ALLOCATION MÉMOIRE DOIT RESPECTER ****** */
 /* ****************************************************************** */
 
-// Les allocations de mémoire doivent se suivre
+// Les allocations de mémoire doivent se suivre (la taille d'un bloc est arrondie pour que le suivant soit aligné)
 void are_memory_allocations_consecutive(const char *test_name, void *ptr1, void *ptr2, size_t ptr1_size) {
-	 cr_assert(((size_t) ptr2 == (size_t) ptr1 + ptr1_size + sizeof(struct struct_canary)),
+	 cr_assert(((size_t) ptr2 == (size_t) ptr1 + ALIGN_SIZE(ptr1_size) + sizeof(struct struct_canary)),
 			 "%s : Les allocations de mémoire ne sont pas placées les unes après les autres, %lx - %lx = %ld",
-			 test_name, (size_t) ptr2, (size_t) ptr1 + ptr1_size + sizeof(struct struct_canary),
-			 (size_t) ptr2 - ((size_t) ptr1 + ptr1_size + sizeof(struct struct_canary)));
+			 test_name, (size_t) ptr2, (size_t) ptr1 + ALIGN_SIZE(ptr1_size) + sizeof(struct struct_canary),
+			 (size_t) ptr2 - ((size_t) ptr1 + ALIGN_SIZE(ptr1_size) + sizeof(struct struct_canary)));
+	 cr_assert((size_t) ptr2 % ALLOCATION_ALIGNMENT == 0, "%s : l'adresse %p n'est pas alignée sur %d octets", test_name, ptr2, ALLOCATION_ALIGNMENT);
 }
 
 // my_malloc ne doit pas retourner NULL
@@ -30,7 +37,7 @@ void metadata_should_correctly_represent_memory_allocation(const char *test_name
 	 cr_assert(metadata->data_ptr == data_ptr, "%s : Le bloc de métadonnées à l'adresse %p ne pointe pas vers "
 			 "l'allocation mémoire de l'adresse %p (il pointe vers %p)", test_name, metadata, data_ptr, metadata->data_ptr);
 
-	 cr_assert(metadata->size == data_size || metadata->size - data_size <= sizeof(struct struct_canary),
+	 cr_assert(metadata->size == ALIGN_SIZE(data_size) || metadata->size - ALIGN_SIZE(data_size) <= sizeof(struct struct_canary),
 			 "%s : la taille réellement allouée (%lu) doit être la même que celle demandée par l'utilisateur (%lu) "
 			 "(sauf s'il y a un excédent qui n'est pas suffisant pour une allocation mémoire supplémentaire)", test_name, metadata->size, data_size);
 
@@ -62,13 +69,29 @@ void create_and_test_2_memory_allocations(const char *test_name, byte **ptr_to_p
 }
 
 struct meta_information  *get_and_test_meta_info_of_memory_allocation(const char *test_name, void *ptr, size_t data_size) {
-	struct meta_information *metadata_of_ptr = metadata_linked_list_map(meta_information_pool_root, 1, is_meta_information_of_memory_ptr, ptr, 0);
+	struct meta_information *metadata_of_ptr = pointer_index_find(ptr);
+	if (metadata_of_ptr != NULL)
+		spinlock_lock(&(metadata_of_ptr->lock));
 	metadata_should_correctly_represent_memory_allocation(test_name, ptr, metadata_of_ptr, data_size);
 
-	mutex_unlock(&(metadata_of_ptr->mutex));
+	spinlock_unlock(&(metadata_of_ptr->lock));
 	return metadata_of_ptr;
 }
 
+// Recherche dans toutes les arènes initialisées
+struct meta_information *metadata_arenas_map(int (*func) (struct meta_information *, void *), void *func_arg2) {
+	for (size_t i = 0; i < arenas_nb; i++) {
+		if (!arenas[i].initialized)
+			continue;
+
+		struct meta_information *result = metadata_linked_list_map(arenas[i].meta_information_pool_root, 1, func, func_arg2, 1);
+		if (result != NULL)
+			return result;
+	}
+
+	return NULL;
+}
+
 void *free_and_test(const char *test_name, void *ptr, size_t prev_free_block_size, size_t next_free_block_size, size_t data_size) {
 	struct meta_information *metadata_of_ptr = get_and_test_meta_info_of_memory_allocation(test_name, ptr, data_size);
 
@@ -79,16 +102,20 @@ void *free_and_test(const char *test_name, void *ptr, size_t prev_free_block_siz
 
 	my_free(ptr);
 
+	// Les tailles des blocs sont arrondies comme lors de l'allocation (ALIGN_SIZE() ne modifie pas la taille d'un bloc)
+	size_t block_size = ALIGN_SIZE(data_size);
+	prev_free_block_size = ALIGN_SIZE(prev_free_block_size);
+	next_free_block_size = ALIGN_SIZE(next_free_block_size);
 	if (prev_status == FREE) {
 		if (next_status == FREE)
 			merge_blocks_when_release_before_or_after_free_block(test_name, prev, prev_free_block_size + sizeof(struct struct_canary)
-					+ data_size + sizeof(struct struct_canary) + next_free_block_size);
+					+ block_size + sizeof(struct struct_canary) + next_free_block_size);
 		else
 			merge_blocks_when_release_before_or_after_free_block(test_name, prev, prev_free_block_size + sizeof(struct struct_canary)
-					+ data_size);
+					+ block_size);
 		return prev->data_ptr;
 	} else if (next_status == FREE) {
-		merge_blocks_when_release_before_or_after_free_block(test_name, metadata_of_ptr, data_size + sizeof(struct struct_canary)
+		merge_blocks_when_release_before_or_after_free_block(test_name, metadata_of_ptr, block_size + sizeof(struct struct_canary)
 				+ next_free_block_size);
 		return ptr;
 	} else {
@@ -103,14 +130,26 @@ void *free_and_test(const char *test_name, void *ptr, size_t prev_free_block_siz
 
 // Utilisation simple d'un mmap() et de munmap()
 Test(my_secmalloc, simple_test_01) {
-    void *ptr = NULL;
-    ptr = init_memeory(ptr, NULL);
+    void *ptr = map_memeory(NULL, get_page_size());
 	cr_assert(ptr != NULL, "Failed to mmap");
 
     int res = munmap(ptr, get_page_size());
     cr_expect(res == 0);
 }
 
+// Un bloc de métadonnées ne doit pas dépasser une ligne de cache
+Test(my_secmalloc, simple_test_02) {
+	cr_assert(sizeof(struct meta_information) <= 64, "La taille d'un bloc de métadonnées (%lu octets) "
+			"ne devrait pas dépasser 64 octets", sizeof(struct meta_information));
+
+	struct spinlock lock;
+	spinlock_init(&lock);
+	cr_assert(spinlock_trylock(&lock), "Un verrou libre devrait pouvoir être pris");
+	cr_assert(!spinlock_trylock(&lock), "Un verrou déjà pris ne devrait pas pouvoir être repris");
+	spinlock_unlock(&lock);
+	cr_assert(spinlock_trylock(&lock), "Un verrou relâché devrait pouvoir être pris");
+}
+
 /* ****************************************************************** */
 /* ********************* TESTS POUR MY_MALLOC *********************** */
 /* ****************************************************************** */
@@ -200,6 +239,52 @@ Test(my_secmalloc, test_my_malloc_05) {
 	}
 }
 
+// L'élargissement des pools ne les déplace pas, et la partie accessible du pool de data est élargie par doublement
+Test(my_secmalloc, test_my_malloc_06) {
+	const char *test_name = "test_my_malloc_06";
+	size_t malloc_size = MMAP_THRESHOLD_DEFAULT / 2; // Les allocations restent dans le pool de data
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, 1);
+	struct struct_canary *data_pool = arenas[0].data_pool;
+	struct meta_information *meta_information_pool_root = arenas[0].meta_information_pool_root;
+
+	for (size_t i = 0; i < 100; i++)
+		create_and_test_memory_allocation(test_name, malloc_size);
+
+	cr_assert(arenas[0].data_pool == data_pool && arenas[0].meta_information_pool_root == meta_information_pool_root
+			&& arenas[0].meta_information_pool_root->data_ptr == (void*) ptr1,
+			"%s : Les pools ne devraient pas être déplacés lors de leur élargissement", test_name);
+
+	size_t committed_size = arenas[0].data_pool_committed_size;
+	cr_assert(committed_size >= arenas[0].data_pool_size && committed_size < 2 * arenas[0].data_pool_size
+			&& committed_size % get_page_size() == 0, "%s : La partie accessible du pool de data (%lu octets) devrait "
+			"contenir le pool de data (%lu octets) sans dépasser le double de sa taille", test_name, committed_size, arenas[0].data_pool_size);
+}
+
+// Les pointeurs renvoyés sont alignés sur ALLOCATION_ALIGNMENT octets, y compris après l'élargissement du pool de data,
+// et le canari du dernier bloc occupe les derniers octets du pool
+Test(my_secmalloc, test_my_malloc_07) {
+	const char *test_name = "test_my_malloc_07";
+	byte *ptrs[300];
+
+	for (size_t i = 0; i < 300; i++) {
+		ptrs[i] = (i % 2 == 0) ? my_malloc(1 + i * 31) : my_calloc(1 + i, 3);
+		cr_assert(ptrs[i] != NULL && (size_t) ptrs[i] % ALLOCATION_ALIGNMENT == 0,
+				"%s : l'adresse %p n'est pas alignée sur %d octets", test_name, ptrs[i], ALLOCATION_ALIGNMENT);
+	}
+	for (size_t i = 0; i < 300; i += 3)
+		my_free(ptrs[i]);
+	for (size_t i = 1; i < 300; i += 3) {
+		ptrs[i] = my_realloc(ptrs[i], 1 + i * 7);
+		cr_assert((size_t) ptrs[i] % ALLOCATION_ALIGNMENT == 0, "%s : l'adresse %p n'est pas alignée après my_realloc()", test_name, ptrs[i]);
+	}
+
+	struct meta_information *last = arenas[0].meta_information_pool_last;
+	cr_assert((size_t) last->data_ptr + last->size + sizeof(struct struct_canary) == (size_t) arenas[0].data_pool + arenas[0].data_pool_size,
+			"%s : le dernier bloc aurait dû s'étendre jusqu'à la fin du pool de data", test_name);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester cohérent", test_name);
+}
+
 
 /* ****************************************************************** */
 /* ********************* TESTS POUR MY_FREE ************************* */
@@ -219,8 +304,8 @@ Test(my_secmalloc, test_my_free_01) {
 	byte *ptr3 = create_and_test_memory_allocation(test_name, malloc_size3);
 	are_memory_allocations_consecutive(test_name, (void *) ptr2, (void *) ptr3, malloc_size2);
 
-	size_t next_free_block_size = get_page_size() - (malloc_size1 + sizeof(struct struct_canary) + malloc_size2
-			+ sizeof(struct struct_canary) + malloc_size3 + sizeof(struct struct_canary) + sizeof(struct struct_canary));
+	size_t next_free_block_size = get_page_size() - (ALIGN_SIZE(malloc_size1) + sizeof(struct struct_canary) + ALIGN_SIZE(malloc_size2)
+			+ sizeof(struct struct_canary) + ALIGN_SIZE(malloc_size3) + sizeof(struct struct_canary) + sizeof(struct struct_canary));
 
 	free_and_test(test_name, ptr2, 0, 0, malloc_size2);
 	free_and_test(test_name, ptr3, malloc_size2, next_free_block_size, malloc_size3);
@@ -276,6 +361,242 @@ Test(my_secmalloc, test_my_free_03) {
 }
 
 
+// La libération d'une allocation située entre deux blocs libres fusionne les trois blocs
+// (seuls les voisins du bloc libéré sont examinés)
+Test(my_secmalloc, test_my_free_04) {
+	const char *test_name = "test_my_free_04";
+	size_t malloc_size1 = 12;
+	size_t malloc_size2 = 25;
+	size_t malloc_size3 = 55;
+	size_t malloc_size4 = 30;
+
+	byte *ptr1;
+	byte *ptr2;
+	byte *ptr3;
+	byte *ptr4;
+	create_and_test_2_memory_allocations(test_name, &ptr1, &ptr2, malloc_size1, malloc_size2);
+	create_and_test_2_memory_allocations(test_name, &ptr3, &ptr4, malloc_size3, malloc_size4);
+
+	struct meta_information *metadata_of_ptr4 = get_and_test_meta_info_of_memory_allocation(test_name, ptr4, malloc_size4);
+
+	free_and_test(test_name, ptr1, 0, 0, malloc_size1);
+	free_and_test(test_name, ptr3, 0, 0, malloc_size3);
+	free_and_test(test_name, ptr2, malloc_size1, malloc_size3, malloc_size2);
+
+	struct meta_information *root = arenas[0].meta_information_pool_root;
+	cr_assert(root->next == metadata_of_ptr4 && metadata_of_ptr4->prev == root, "%s : Après la fusion, le bloc libre "
+			"devrait être directement suivi par l'allocation ptr4", test_name);
+}
+
+// Le bloc de métadonnées libéré par une fusion est rendu à la bitmap des blocs inutilisés, puis réutilisé
+Test(my_secmalloc, test_my_free_05) {
+	const char *test_name = "test_my_free_05";
+	size_t malloc_size = 12;
+
+	byte *ptr1;
+	byte *ptr2;
+	create_and_test_2_memory_allocations(test_name, &ptr1, &ptr2, malloc_size, malloc_size);
+
+	struct meta_information *root = arenas[0].meta_information_pool_root;
+	cr_assert(root[1].data_ptr == (void*) ptr2 && root[2].status == FREE, "%s : Les blocs de métadonnées inutilisés "
+			"devraient être attribués dans l'ordre du pool de meta-information", test_name);
+
+	// ptr2 est fusionné avec le bloc libre suivant, dont le bloc de métadonnées devient inutilisé
+	my_free(ptr2);
+	cr_assert(root[2].status == UNUSED && (arenas[0].unused_bitmap[0] & ((size_t) 1 << 2)) && !(arenas[0].unused_bitmap[0] & ((size_t) 1 << 1)),
+			"%s : Le bloc de métadonnées libéré par la fusion devrait être marqué comme inutilisé dans la bitmap", test_name);
+
+	byte *ptr3 = create_and_test_memory_allocation(test_name, malloc_size);
+	struct meta_information *metadata_of_ptr3 = get_and_test_meta_info_of_memory_allocation(test_name, ptr3, malloc_size);
+	cr_assert(metadata_of_ptr3 == &root[1] && metadata_of_ptr3->next == &root[2], "%s : Le bloc de métadonnées "
+			"inutilisé aurait dû être réutilisé", test_name);
+}
+
+// Un bloc libéré est rangé dans la liste de blocs libres de sa classe de taille, puis réutilisé par une allocation
+// de la même classe ; si la classe est vide, un bloc d'une classe supérieure est découpé
+Test(my_secmalloc, test_free_lists_01) {
+	const char *test_name = "test_free_lists_01";
+	size_t malloc_size1 = 40;
+	size_t malloc_size2 = 1000;
+	size_t separator_size = 24;
+
+	// Les blocs libérés sont séparés par des blocs occupés afin qu'aucune fusion n'ait lieu
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size1);
+	create_and_test_memory_allocation(test_name, separator_size);
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size2);
+	create_and_test_memory_allocation(test_name, separator_size);
+
+	struct meta_information *metadata_of_ptr1 = get_and_test_meta_info_of_memory_allocation(test_name, ptr1, malloc_size1);
+	struct meta_information *metadata_of_ptr2 = get_and_test_meta_info_of_memory_allocation(test_name, ptr2, malloc_size2);
+	size_t index1 = get_free_list_index(ALIGN_SIZE(malloc_size1));
+	size_t index2 = get_free_list_index(ALIGN_SIZE(malloc_size2));
+
+	my_free(ptr1);
+	my_free(ptr2);
+	cr_assert(arenas[0].free_lists[index1].head == metadata_of_ptr1 && arenas[0].free_lists[index2].head == metadata_of_ptr2
+			&& (arenas[0].free_lists_bitmap & ((size_t) 1 << index1)) && (arenas[0].free_lists_bitmap & ((size_t) 1 << index2)),
+			"%s : les blocs libérés auraient dû être placés en tête de la liste de leur classe de taille", test_name);
+
+	// Même classe de taille : le bloc libéré est réutilisé et sa classe devient vide
+	byte *ptr3 = create_and_test_memory_allocation(test_name, malloc_size1 - 7);
+	cr_assert(ptr3 == ptr1, "%s : le bloc libéré de la même classe aurait dû être réutilisé ptr3 %lx != ptr1 %lx",
+			test_name, (size_t) ptr3, (size_t) ptr1);
+	cr_assert(arenas[0].free_lists[index1].head == NULL && !(arenas[0].free_lists_bitmap & ((size_t) 1 << index1)),
+			"%s : la liste de la classe de taille %lu aurait dû devenir vide", test_name, index1);
+
+	// Aucune classe intermédiaire ne contient de bloc : le bloc de la classe supérieure est découpé
+	size_t malloc_size4 = 100;
+	cr_assert(get_free_list_index(ALIGN_SIZE(malloc_size4)) < index2, "%s : la taille %lu devrait appartenir à une classe inférieure", test_name, malloc_size4);
+	byte *ptr4 = create_and_test_memory_allocation(test_name, malloc_size4);
+	cr_assert(ptr4 == ptr2, "%s : le bloc libre de la classe supérieure aurait dû être utilisé ptr4 %lx != ptr2 %lx",
+			test_name, (size_t) ptr4, (size_t) ptr2);
+
+	struct meta_information *remainder = metadata_of_ptr2->next;
+	size_t remainder_size = ALIGN_SIZE(malloc_size2) - ALIGN_SIZE(malloc_size4) - sizeof(struct struct_canary);
+	cr_assert(remainder->status == FREE && remainder->size == remainder_size
+			&& arenas[0].free_lists[get_free_list_index(remainder_size)].head == remainder,
+			"%s : le reste du bloc découpé (%lu octets) aurait dû être rangé dans la liste de sa classe de taille", test_name, remainder_size);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester cohérent", test_name);
+}
+
+// meta_information_pool_last désigne toujours le dernier bloc de la liste chaînée (qui s'étend jusqu'à la fin du pool de data)
+Test(my_secmalloc, test_free_lists_02) {
+	const char *test_name = "test_free_lists_02";
+	size_t malloc_size = 72;
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size);
+	struct meta_information *metadata_of_ptr2 = get_and_test_meta_info_of_memory_allocation(test_name, ptr2, malloc_size);
+
+	struct meta_information *last = arenas[0].meta_information_pool_last;
+	cr_assert(last->next == NULL && last->prev == metadata_of_ptr2 && last->status == FREE,
+			"%s : le dernier bloc aurait dû être le bloc libre qui suit ptr2", test_name);
+
+	// ptr2 est fusionné avec le dernier bloc, dont le bloc de métadonnées devient inutilisé
+	my_free(ptr2);
+	last = arenas[0].meta_information_pool_last;
+	cr_assert(last == metadata_of_ptr2 && last->next == NULL && last->status == FREE,
+			"%s : après la fusion, le dernier bloc aurait dû être celui de ptr2", test_name);
+
+	// L'élargissement du pool de data agrandit ou remplace le dernier bloc
+	for (size_t i = 0; i < 64; i++)
+		create_and_test_memory_allocation(test_name, MMAP_THRESHOLD_DEFAULT / 2);
+
+	last = arenas[0].meta_information_pool_last;
+	cr_assert(last->next == NULL && (size_t) last->data_ptr + last->size + sizeof(struct struct_canary)
+			== (size_t) arenas[0].data_pool + arenas[0].data_pool_size,
+			"%s : le dernier bloc aurait dû s'étendre jusqu'à la fin du pool de data", test_name);
+
+	my_free(ptr1);
+	cr_assert(arenas[0].meta_information_pool_last == last, "%s : la libération du premier bloc ne devrait pas modifier le dernier bloc", test_name);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester cohérent", test_name);
+}
+
+// L'index des pointeurs ne retrouve que l'adresse de début d'un bloc occupé
+Test(my_secmalloc, test_pointer_index_01) {
+	const char *test_name = "test_pointer_index_01";
+	size_t malloc_size = 48;
+	int local_variable = 0;
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size);
+	cr_assert(pointer_index_find(ptr1) != NULL && pointer_index_find(ptr1)->data_ptr == (void*) ptr1,
+			"%s : le bloc de métadonnées de ptr1 aurait dû être retrouvé", test_name);
+
+	cr_assert(pointer_index_find(ptr1 + 1) == NULL && pointer_index_find(ptr1 + malloc_size / 2) == NULL,
+			"%s : un pointeur vers l'intérieur d'un bloc ne devrait pas être retrouvé", test_name);
+	cr_assert(pointer_index_find(&local_variable) == NULL && pointer_index_find(NULL) == NULL,
+			"%s : un pointeur inconnu ne devrait pas être retrouvé", test_name);
+
+	my_free(ptr1);
+	cr_assert(pointer_index_find(ptr1) == NULL, "%s : un pointeur libéré ne devrait plus être retrouvé", test_name);
+	cr_assert(pointer_index_find(ptr2) != NULL && pointer_index_find(ptr2)->data_ptr == (void*) ptr2,
+			"%s : le bloc de métadonnées de ptr2 aurait dû être retrouvé", test_name);
+}
+
+// Tous les blocs occupés sont retrouvés après l'agrandissement de la table de l'index des pointeurs
+Test(my_secmalloc, test_pointer_index_02) {
+	const char *test_name = "test_pointer_index_02";
+	size_t malloc_size = 16;
+
+	byte *first_ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	size_t buckets_nb = pointer_index.buckets_nb;
+	size_t ptrs_nb = 3 * buckets_nb;
+	byte **ptrs = (byte **) create_and_test_memory_allocation(test_name, ptrs_nb * sizeof(byte *));
+
+	for (size_t i = 0; i < ptrs_nb; i++)
+		ptrs[i] = create_and_test_memory_allocation(test_name, malloc_size);
+
+	cr_assert(pointer_index.buckets_nb > buckets_nb, "%s : la table (%lu cases) aurait dû être agrandie au-delà de %lu blocs occupés",
+			test_name, buckets_nb, POINTER_INDEX_MAX_LOAD * buckets_nb);
+
+	cr_assert(pointer_index_find(first_ptr) != NULL && pointer_index_find(first_ptr)->data_ptr == (void*) first_ptr
+			&& pointer_index_find(ptrs) != NULL, "%s : les blocs alloués avant l'agrandissement auraient dû être retrouvés", test_name);
+	for (size_t i = 0; i < ptrs_nb; i++) {
+		struct meta_information *metadata_of_ptr = pointer_index_find(ptrs[i]);
+		cr_assert(metadata_of_ptr != NULL && metadata_of_ptr->data_ptr == (void*) ptrs[i] && metadata_of_ptr->status == BUSY,
+				"%s : le bloc occupé %p aurait dû être retrouvé après l'agrandissement", test_name, ptrs[i]);
+	}
+
+	// Les blocs libérés sont retirés de la nouvelle table
+	for (size_t i = 0; i < ptrs_nb; i += 2)
+		my_free(ptrs[i]);
+	for (size_t i = 0; i < ptrs_nb; i++)
+		cr_assert((pointer_index_find(ptrs[i]) == NULL) == (i % 2 == 0), "%s : l'index ne correspond pas aux blocs occupés (%p)", test_name, ptrs[i]);
+}
+
+/* ****************************************************************** */
+/* ********************* TESTS POUR MY_CALLOC *********************** */
+/* ****************************************************************** */
+
+// Si la multiplication nmemb * size dépasse la valeur maximale d'un size_t, my_calloc() renvoie NULL
+Test(my_secmalloc, test_my_calloc_01) {
+	const char *test_name = "test_my_calloc_01";
+
+	void *ptr = my_calloc(((size_t) -1) / 2, 4);
+	cr_assert(ptr == NULL, "%s : my_calloc() aurait dû renvoyer NULL", test_name);
+}
+
+// Un bloc nettoyé lors de sa libération est connu comme ne contenant que des zéros
+Test(my_secmalloc, test_my_calloc_02) {
+	const char *test_name = "test_my_calloc_02";
+	size_t malloc_size = 100;
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	struct meta_information *metadata_of_ptr1 = pointer_index_find(ptr1);
+	memset(ptr1, 't', malloc_size);
+	my_free(ptr1);
+
+	cr_assert(metadata_of_ptr1->status == FREE && metadata_of_ptr1->zeroed == 1,
+			"%s : le bloc libéré aurait dû être connu comme ne contenant que des zéros", test_name);
+
+	byte *ptr2 = my_calloc(malloc_size, 1);
+	cr_assert(ptr2 == ptr1, "%s : le bloc libéré aurait dû être réutilisé", test_name);
+	for (size_t i = 0; i < malloc_size; i++)
+		cr_assert(ptr2[i] == 0, "%s : la mémoire allouée par my_calloc() n'a pas été mise à zéro", test_name);
+}
+
+// Un bloc libre dont le contenu est inconnu est mis à zéro par my_calloc()
+Test(my_secmalloc, test_my_calloc_03) {
+	const char *test_name = "test_my_calloc_03";
+	size_t malloc_size = 1000;
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	create_and_test_memory_allocation(test_name, 12);
+	memset(ptr1, 't', malloc_size);
+
+	// La fin du bloc, qui n'a pas été nettoyée, devient un bloc libre
+	my_realloc(ptr1, 100);
+	struct meta_information *remainder_metadata = pointer_index_find(ptr1)->next;
+	cr_assert(remainder_metadata->status == FREE && remainder_metadata->zeroed == 0,
+			"%s : le contenu du bloc libre issu de la réduction aurait dû être inconnu", test_name);
+
+	byte *ptr2 = my_calloc(malloc_size - 200, 1);
+	cr_assert(ptr2 == (byte*) remainder_metadata->data_ptr, "%s : le bloc libre aurait dû être réutilisé", test_name);
+	for (size_t i = 0; i < malloc_size - 200; i++)
+		cr_assert(ptr2[i] == 0, "%s : la mémoire allouée par my_calloc() n'a pas été mise à zéro", test_name);
+}
+
 /* ****************************************************************** */
 /* ********************* TESTS POUR MY_REALLOC ********************** */
 /* ****************************************************************** */
@@ -317,11 +638,11 @@ Test(my_secmalloc, test_my_realloc_02) {
 			" metadata_of_ptr1 %lx != metadata_of_ptr2 %lx", (size_t) metadata_of_ptr1, (size_t) metadata_of_ptr2);
 }
 
-// Réduire l'espace mémoire de telle manière qu'il ne reste pas de place pour une allocation supplémentaire
-// La surface restante est inférieure ou égale à sizeof(struct chunck)
+// Réduire l'espace mémoire lorsque le bloc suivant est libre : le bloc suivant recule
+// (les tailles étant arrondies, la surface restante est toujours suffisante pour un bloc libre)
 Test(my_secmalloc, test_my_realloc_03) {
 	const char *test_name = "test_my_realloc_03";
-	size_t malloc_size = 5;
+	size_t malloc_size = 20;
 	size_t realloc_size = 1;
 
 	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
@@ -339,9 +660,9 @@ Test(my_secmalloc, test_my_realloc_03) {
 	cr_assert(metadata_of_ptr1 == metadata_of_ptr2, "Un appel à my_realloc ne devrait pas modifier l'adresse du bloc de métadonnées"
 			" metadata_of_ptr1 %lx != metadata_of_ptr2 %lx", (size_t) metadata_of_ptr1, (size_t) metadata_of_ptr2);
 
-	cr_assert(next_data_ptr_before - (size_t) metadata_of_ptr2->next->data_ptr == (malloc_size - realloc_size),
+	cr_assert(next_data_ptr_before - (size_t) metadata_of_ptr2->next->data_ptr == ALIGN_SIZE(malloc_size) - ALIGN_SIZE(realloc_size),
 			"Après avoir appelé my_realloc(), l'adresse de la prochaine allocation de mémoire était censée reculer de %lu octets : %lx != %lx",
-			malloc_size - realloc_size, next_data_ptr_before, (size_t) metadata_of_ptr2->next->data_ptr);
+			ALIGN_SIZE(malloc_size) - ALIGN_SIZE(realloc_size), next_data_ptr_before, (size_t) metadata_of_ptr2->next->data_ptr);
 }
 
 // Augmentation de la taille d'une allocation mémoire
@@ -404,6 +725,77 @@ Test(my_secmalloc, test_my_realloc_06) {
 }
 
 
+// Une réduction de l'espace mémoire lorsque le bloc suivant est libre : le nouveau bloc libre est fusionné avec lui
+Test(my_secmalloc, test_my_realloc_08) {
+	const char *test_name = "test_my_realloc_08";
+	size_t malloc_size = 100;
+	size_t realloc_size = 40;
+
+	byte *ptr1;
+	byte *ptr2;
+	create_and_test_2_memory_allocations(test_name, &ptr1, &ptr2, malloc_size, malloc_size);
+	byte *ptr3 = create_and_test_memory_allocation(test_name, malloc_size);
+
+	struct meta_information *metadata_of_ptr1 = get_and_test_meta_info_of_memory_allocation(test_name, ptr1, malloc_size);
+	struct meta_information *metadata_of_ptr3 = get_and_test_meta_info_of_memory_allocation(test_name, ptr3, malloc_size);
+	my_free(ptr2);
+
+	byte *ptr4 = my_realloc(ptr1, realloc_size);
+	cr_assert(ptr4 == ptr1, "Un appel à my_realloc avec une taille de mémoire plus petite devrait renvoyer un "
+			"pointeur vers la même zone mémoire ptr4 %lx != ptr1 %lx", (size_t) ptr4, (size_t) ptr1);
+
+	struct meta_information *next = metadata_of_ptr1->next;
+	size_t expected_size = (ALIGN_SIZE(malloc_size) - ALIGN_SIZE(realloc_size) - sizeof(struct struct_canary)) + sizeof(struct struct_canary)
+			+ ALIGN_SIZE(malloc_size);
+	cr_assert(next->status == FREE && next->size == expected_size && next->next == metadata_of_ptr3 && metadata_of_ptr3->prev == next,
+			"%s : Le bloc libre créé par my_realloc() devrait être fusionné avec le bloc libre suivant (taille %lu, attendue %lu)",
+			test_name, next->size, expected_size);
+}
+
+// Le dernier bloc (suivi du dernier bloc libre, trop petit) est agrandi sur place en élargissant le pool de data
+Test(my_secmalloc, test_my_realloc_09) {
+	const char *test_name = "test_my_realloc_09";
+	size_t malloc_size = 1000;
+	size_t realloc_size = get_page_size() + MMAP_THRESHOLD_DEFAULT / 4;
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	memset(ptr1, 't', malloc_size);
+	size_t data_pool_size = arenas[0].data_pool_size;
+
+	byte *ptr2 = my_realloc(ptr1, realloc_size);
+	cr_assert(ptr2 == ptr1 && arenas[0].data_pool_size > data_pool_size,
+			"%s : le bloc aurait dû être agrandi sur place ptr2 %lx != ptr1 %lx", test_name, (size_t) ptr2, (size_t) ptr1);
+	get_and_test_meta_info_of_memory_allocation(test_name, ptr2, realloc_size);
+	for (size_t i = 0; i < malloc_size; i++)
+		cr_assert(ptr2[i] == 't', "%s : le contenu de l'allocation n'a pas été conservé", test_name);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester intact", test_name);
+}
+
+// Une grande allocation est agrandie avec mremap(), sans copie
+Test(my_secmalloc, test_my_realloc_10) {
+	const char *test_name = "test_my_realloc_10";
+	size_t malloc_size = 2 * MMAP_THRESHOLD_DEFAULT;
+	size_t realloc_size = 16 * MMAP_THRESHOLD_DEFAULT;
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	for (size_t i = 0; i < malloc_size; i++)
+		ptr1[i] = (byte) i;
+
+	byte *ptr2 = my_realloc(ptr1, realloc_size);
+	struct meta_information *metadata_of_ptr2 = pointer_index_find(ptr2);
+	cr_assert(metadata_of_ptr2 != NULL && metadata_of_ptr2->status == MAPPED && metadata_of_ptr2->size == realloc_size
+			&& (ptr2 == ptr1 || pointer_index_find(ptr1) == NULL),
+			"%s : la grande allocation aurait dû être agrandie", test_name);
+	for (size_t i = 0; i < malloc_size; i++)
+		cr_assert(ptr2[i] == (byte) i, "%s : le contenu de l'allocation n'a pas été conservé", test_name);
+
+	memset(ptr2, 't', realloc_size);
+	byte *ptr3 = my_realloc(ptr2, malloc_size);
+	cr_assert(ptr3 == ptr2 && pointer_index_find(ptr3)->size == malloc_size,
+			"%s : la grande allocation aurait dû être réduite sur place", test_name);
+	my_free(ptr3);
+}
+
 Test(my_secmalloc, test_my_realloc_07) {
 	const char *test_name = "test_my_realloc_07";
 	size_t malloc_size = 50;
@@ -436,7 +828,7 @@ Test(my_secmalloc, test_overflow_02, .exit_code = EXIT_FAILURE) {
 	size_t malloc_size = 12;
 
 	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
-	ptr[malloc_size] = 't';
+	ptr[ALIGN_SIZE(malloc_size)] = 't';
 
 	// Pour éviter les messages de type
 	// "Warning! The test `my_secmalloc::test_overflow_02` exited during its setup or teardown."
@@ -473,11 +865,912 @@ Test(my_secmalloc, test_overflow_07, .exit_code = EXIT_FAILURE) {
 	const char *test_name = "test_overflow_07";
 	size_t malloc_size = 12;
 
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	ptr[ALIGN_SIZE(malloc_size)] = 't';
+	my_free(ptr);
+}
+
+// Détection dynamique de l’overflow d'un bloc récemment alloué, vérifié en priorité à chaque passage
+Test(my_secmalloc, test_overflow_08, .exit_code = EXIT_FAILURE) {
+	const char *test_name = "test_overflow_08";
+	size_t malloc_size = 12;
+	setenv("MSM_SCAN_BATCH", "1", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	ptr[ALIGN_SIZE(malloc_size)] = 't';
+	sleep(2);
+}
+
+// Détection dynamique de l’overflow d'un bloc plus ancien, par passages successifs de taille bornée
+Test(my_secmalloc, test_overflow_09, .exit_code = EXIT_FAILURE) {
+	const char *test_name = "test_overflow_09";
+	size_t malloc_size = 12;
+	setenv("MSM_SCAN_BATCH", "32", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	ptr[ALIGN_SIZE(malloc_size)] = 't';
+
+	// Le bloc ne fait plus partie des blocs récemment alloués
+	for (size_t i = 0; i < 2 * RECENT_BLOCKS_NB; i++)
+		create_and_test_memory_allocation(test_name, malloc_size);
+	sleep(3);
+}
+
+/* ****************************************************************** */
+/* ************** VÉRIFICATION DE L'INTÉGRITÉ DU TAS **************** */
+/* ****************************************************************** */
+
+// Le tas est intact après des allocations, des redimensionnements et des libérations
+Test(my_secmalloc, test_check_01) {
+	const char *test_name = "test_check_01";
+	byte *ptrs[100];
+
+	for (size_t i = 0; i < 100; i++)
+		ptrs[i] = create_and_test_memory_allocation(test_name, 1 + i * 37);
+	for (size_t i = 0; i < 100; i += 3)
+		my_free(ptrs[i]);
+	for (size_t i = 1; i < 100; i += 3)
+		ptrs[i] = my_realloc(ptrs[i], 1 + i * 53);
+	create_and_test_memory_allocation(test_name, 2 * MMAP_THRESHOLD_DEFAULT);
+
+	size_t errors_nb = secmalloc_check();
+	cr_assert(errors_nb == 0, "%s : secmalloc_check() n'aurait dû détecter aucune incohérence (%lu détectées)", test_name, errors_nb);
+}
+
+// Détection d'un canari écrasé et d'un chaînage incohérent
+Test(my_secmalloc, test_check_02) {
+	const char *test_name = "test_check_02";
+	size_t malloc_size = 12;
+	// Le thread de parcours du tas ne doit pas détecter l'overflow avant secmalloc_check()
+	setenv("MSM_SCAN_INTERVAL_MS", "60000", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	create_and_test_memory_allocation(test_name, malloc_size);
+	sleep(1);
+
+	ptr1[ALIGN_SIZE(malloc_size)] ^= 1;
+	cr_assert(secmalloc_check() == 1, "%s : secmalloc_check() aurait dû détecter le canari écrasé", test_name);
+	ptr1[ALIGN_SIZE(malloc_size)] ^= 1;
+
+	struct meta_information *metadata_of_ptr1 = pointer_index_find(ptr1);
+	struct meta_information *prev_of_next = metadata_of_ptr1->next->prev;
+	metadata_of_ptr1->next->prev = NULL;
+	cr_assert(secmalloc_check() == 1, "%s : secmalloc_check() aurait dû détecter le chaînage incohérent", test_name);
+	metadata_of_ptr1->next->prev = prev_of_next;
+
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû être de nouveau intact", test_name);
+}
+
+/* ****************************************************************** */
+/* ************ RESTITUTION DE LA MÉMOIRE AU SYSTÈME ***************** */
+/* ****************************************************************** */
+
+// Le pool de data est réduit lorsque son dernier bloc est libre, et il peut de nouveau être élargi
+Test(my_secmalloc, test_trim_01) {
+	const char *test_name = "test_trim_01";
+	size_t malloc_size = MMAP_THRESHOLD_DEFAULT / 2;
+	byte *ptrs[20];
+
+	for (size_t i = 0; i < 20; i++)
+		ptrs[i] = create_and_test_memory_allocation(test_name, malloc_size);
+	for (size_t i = 0; i < 20; i++)
+		my_free(ptrs[i]);
+
+	size_t committed_size = arenas[0].data_pool_committed_size;
+	size_t released_size = secmalloc_trim();
+	cr_assert(released_size >= committed_size - get_page_size() && arenas[0].data_pool_size == get_page_size()
+			&& arenas[0].data_pool_committed_size == get_page_size(),
+			"%s : le pool de data aurait dû être réduit à une page (%lu octets rendus au système)", test_name, released_size);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester intact", test_name);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, 4 * malloc_size);
+	memset(ptr, 't', 4 * malloc_size);
+	my_free(ptr);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester intact après un nouvel élargissement", test_name);
+}
+
+// Les pages entièrement contenues dans un bloc libre au milieu du pool de data sont rendues au système
+Test(my_secmalloc, test_trim_02) {
+	const char *test_name = "test_trim_02";
+	size_t page_size = get_page_size();
+	size_t malloc_size = 4 * page_size;
+
+	create_and_test_memory_allocation(test_name, 1000);
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	create_and_test_memory_allocation(test_name, 1000);
+	memset(ptr, 't', malloc_size);
+	my_free(ptr);
+
+	cr_assert(secmalloc_trim() >= 2 * page_size, "%s : les pages du bloc libre auraient dû être rendues au système", test_name);
+
+	byte *first_page = (byte*) (((size_t) ptr + page_size - 1) & ~(page_size - 1));
+	unsigned char resident[2];
+	cr_assert(mincore(first_page, 2 * page_size, resident) == 0 && !(resident[0] & 1) && !(resident[1] & 1),
+			"%s : les pages du bloc libre n'auraient plus dû être résidentes", test_name);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester intact", test_name);
+}
+
+/* ****************************************************************** */
+/* ************************* STATISTIQUES *************************** */
+/* ****************************************************************** */
+
+// Les statistiques reflètent les blocs occupés et libres, et les compteurs de chaque opération
+Test(my_secmalloc, test_stats_01) {
+	const char *test_name = "test_stats_01";
+	byte *ptrs[10];
+
+	for (size_t i = 0; i < 10; i++)
+		ptrs[i] = create_and_test_memory_allocation(test_name, 100);
+	create_and_test_memory_allocation(test_name, 2 * MMAP_THRESHOLD_DEFAULT);
+	my_calloc(10, 100);
+	for (size_t i = 0; i < 3; i++)
+		my_free(ptrs[i]);
+
+	struct secmalloc_stats stats;
+	secmalloc_stats(&stats);
+
+	cr_assert(stats.busy_blocks_nb == 8 && stats.mapped_blocks_nb == 1 && stats.free_blocks_nb >= 1,
+			"%s : 8 blocs occupés et une grande allocation étaient attendus (%lu, %lu)", test_name, stats.busy_blocks_nb, stats.mapped_blocks_nb);
+	cr_assert(stats.live_bytes == 7 * ALIGN_SIZE(100) + ALIGN_SIZE(1000) + 2 * MMAP_THRESHOLD_DEFAULT && stats.free_bytes >= 3 * 100
+			&& stats.largest_free_block > 0 && stats.largest_free_block <= stats.free_bytes,
+			"%s : nombre d'octets occupés ou libres inattendu (%lu, %lu)", test_name, stats.live_bytes, stats.free_bytes);
+	cr_assert(stats.mapped_bytes >= stats.live_bytes + stats.free_bytes && stats.metadata_bytes > 0,
+			"%s : la mémoire mappée aurait dû contenir les blocs occupés et libres", test_name);
+	cr_assert(stats.allocations_nb == 12 && stats.frees_nb == 3 && stats.calloc_calls_nb == 1 && stats.realloc_calls_nb == 0,
+			"%s : compteurs d'opérations inattendus (%lu allocations, %lu libérations)", test_name, stats.allocations_nb, stats.frees_nb);
+	cr_assert(stats.size_classes[6] == 10 && stats.size_classes[9] == 1 && stats.size_classes[18] == 1,
+			"%s : chaque allocation aurait dû être comptée dans sa classe de taille", test_name);
+}
+
+// Le signal MSM_STATS_SIGNAL provoque l'écriture des statistiques sur la sortie d'erreur
+Test(my_secmalloc, test_stats_02) {
+	const char *test_name = "test_stats_02";
+	const char *stderr_file_path = "/tmp/msm_test_stats_02";
+	setenv("MSM_STATS_SIGNAL", "12", 1); // SIGUSR2
+	setenv("MSM_SCAN_INTERVAL_MS", "10", 1);
+
+	int file_descriptor = open(stderr_file_path, O_CREAT | O_TRUNC | O_RDWR, 0644);
+	dup2(file_descriptor, STDERR_FILENO);
+
+	create_and_test_memory_allocation(test_name, 100);
+	raise(SIGUSR2);
+	sleep(1);
+
+	char text[4096] = { 0 };
+	pread(file_descriptor, text, sizeof(text) - 1, 0);
+	close(file_descriptor);
+	unlink(stderr_file_path);
+
+	cr_assert(strstr(text, "secmalloc : ") != NULL && strstr(text, "1 allocations de 64 a 127 octets") != NULL,
+			"%s : les statistiques auraient dû être écrites sur la sortie d'erreur", test_name);
+}
+
+// MSM_STATS_SIGNAL ne peut pas détourner SIGUSR1 : un double free termine toujours le programme
+Test(my_secmalloc, test_stats_03, .signal = SIGUSR1) {
+	const char *test_name = "test_stats_03";
+	setenv("MSM_STATS_SIGNAL", "10", 1); // SIGUSR1
+
+	byte *ptr = create_and_test_memory_allocation(test_name, 12);
+	cr_assert(stats_signal == 0, "%s : SIGUSR1 n'aurait pas dû être utilisé pour les statistiques", test_name);
+	my_free(ptr);
+	my_free(ptr);
+}
+
+// Un signal qui ne peut pas être intercepté, ou hors limites, désactive l'écriture des statistiques sans arrêter le programme
+Test(my_secmalloc, test_stats_04) {
+	const char *test_name = "test_stats_04";
+	setenv("MSM_STATS_SIGNAL", "9", 1); // SIGKILL
+
+	create_and_test_memory_allocation(test_name, 12);
+	cr_assert(stats_signal == 0, "%s : SIGKILL n'aurait pas dû être utilisé pour les statistiques", test_name);
+}
+
+/* ****************************************************************** */
+/* ******************** PAGES DE GRANDE TAILLE ********************** */
+/* ****************************************************************** */
+
+// Le pool de data est aligné sur une page de grande taille, et élargi ou réduit par multiples de HUGE_PAGE_SIZE
+Test(my_secmalloc, test_huge_pages_01) {
+	const char *test_name = "test_huge_pages_01";
+	size_t malloc_size = MMAP_THRESHOLD_DEFAULT / 2;
+	byte *ptrs[40];
+	setenv("MSM_HUGE_PAGES", "1", 1);
+
+	for (size_t i = 0; i < 40; i++) {
+		ptrs[i] = create_and_test_memory_allocation(test_name, malloc_size);
+		memset(ptrs[i], 'h', malloc_size);
+	}
+
+	cr_assert((size_t) arenas[0].data_pool % HUGE_PAGE_SIZE == 0 && arenas[0].data_pool_committed_size % HUGE_PAGE_SIZE == 0
+			&& arenas[0].data_pool_committed_size >= arenas[0].data_pool_size,
+			"%s : le pool de data aurait dû être aligné et engagé par pages de grande taille (%p, %lu)", test_name,
+			arenas[0].data_pool, arenas[0].data_pool_committed_size);
+
+	struct secmalloc_stats stats;
+	secmalloc_stats(&stats);
+	cr_assert(stats.huge_page_bytes % HUGE_PAGE_SIZE == 0 && stats.huge_page_bytes <= arenas[0].data_pool_committed_size,
+			"%s : nombre d'octets en pages de grande taille inattendu (%lu)", test_name, stats.huge_page_bytes);
+
+	for (size_t i = 0; i < 40; i++)
+		my_free(ptrs[i]);
+
+	secmalloc_trim();
+	cr_assert(arenas[0].data_pool_committed_size == HUGE_PAGE_SIZE && arenas[0].data_pool_size == get_page_size(),
+			"%s : le pool de data aurait dû être réduit à une page de grande taille (%lu)", test_name, arenas[0].data_pool_committed_size);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester intact", test_name);
+}
+
+// Après la réduction du pool de data, la mémoire qui reste engagée (fin de la page de grande taille) ne contient que des zéros
+Test(my_secmalloc, test_huge_pages_02) {
+	const char *test_name = "test_huge_pages_02";
+	size_t malloc_size = HUGE_PAGE_SIZE / 2;
+	setenv("MSM_HUGE_PAGES", "1", 1);
+	setenv("MSM_MMAP_THRESHOLD", "8388608", 1);
+
+	// L'ancienne fin du pool (et le canari du dernier bloc) reste dans la première page de grande taille
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	memset(ptr, 'h', malloc_size);
+	my_free(ptr);
+	secmalloc_trim();
+
+	byte *calloc_result = my_calloc(1, 2 * malloc_size);
+	cr_assert(calloc_result != NULL, "%s : my_calloc() aurait dû réussir", test_name);
+	for (size_t i = 0; i < 2 * malloc_size; i++)
+		cr_assert(calloc_result[i] == 0, "%s : l'octet %lu aurait dû être nul", test_name, i);
+}
+
+/* ****************************************************************** */
+/* ****************** SLABS (PETITES ALLOCATIONS) ******************* */
+/* ****************************************************************** */
+
+// Les petites allocations occupent des emplacements de slabs, sans bloc de métadonnées, et sont réutilisées après libération
+Test(my_secmalloc, test_slabs_01) {
+	const char *test_name = "test_slabs_01";
+	size_t malloc_size = 24;
+	byte *ptrs[200];
+	setenv("MSM_SLABS", "1", 1);
+
+	for (size_t i = 0; i < 200; i++) {
+		ptrs[i] = create_and_test_memory_allocation(test_name, malloc_size);
+		memset(ptrs[i], 's', malloc_size);
+	}
+
+	cr_assert(is_in_slab_pool(ptrs[0]) && is_in_slab_pool(ptrs[199]) && (size_t) ptrs[1] % ALLOCATION_ALIGNMENT == 0
+			&& pointer_index_find(ptrs[0]) == NULL && ptrs[1] == ptrs[0] + 32,
+			"%s : les petites allocations auraient dû occuper des emplacements consécutifs d'un slab", test_name);
+	cr_assert(my_malloc_usable_size(ptrs[0]) == 32 - SLAB_CANARY_SIZE,
+			"%s : un emplacement de 32 octets aurait dû contenir %lu octets utilisables", test_name, 32 - SLAB_CANARY_SIZE);
+
+	struct secmalloc_stats stats;
+	secmalloc_stats(&stats);
+	cr_assert(stats.slab_slots_nb == 200 && stats.slab_bytes == 2 * SLAB_SIZE,
+			"%s : 200 emplacements occupés dans 2 slabs étaient attendus (%lu, %lu)", test_name, stats.slab_slots_nb, stats.slab_bytes);
+
+	my_free(ptrs[10]);
+	byte *ptr = my_calloc(1, malloc_size);
+	cr_assert(ptr == ptrs[10] && ptr[0] == 0 && ptr[malloc_size - 1] == 0,
+			"%s : l'emplacement libéré aurait dû être réutilisé et ne contenir que des zéros", test_name);
+
+	byte *realloc_result = my_realloc(ptr, 200);
+	cr_assert(realloc_result != ptr && is_in_slab_pool(realloc_result) && my_malloc_usable_size(realloc_result) >= 200,
+			"%s : l'allocation aurait dû être déplacée vers un emplacement plus grand", test_name);
+	realloc_result = my_realloc(realloc_result, 1000);
+	cr_assert(!is_in_slab_pool(realloc_result) && pointer_index_find(realloc_result) != NULL,
+			"%s : l'allocation aurait dû être déplacée dans le pool de data", test_name);
+
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester intact", test_name);
+	for (size_t i = 0; i < 200; i++) {
+		if (i != 10)
+			my_free(ptrs[i]);
+	}
+
+	// Le premier slab reste le seul slab non plein de sa classe, le second est rendu au pool puis au système
+	cr_assert(secmalloc_trim() >= SLAB_SIZE, "%s : le slab vide aurait dû être rendu au système", test_name);
+}
+
+// Un débordement dans le canari compact d'un emplacement est détecté lors de sa libération
+Test(my_secmalloc, test_slabs_02, .exit_code = EXIT_FAILURE) {
+	const char *test_name = "test_slabs_02";
+	size_t malloc_size = 40;
+	setenv("MSM_SLABS", "1", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	ptr[my_malloc_usable_size(ptr)] ^= 1;
+	my_free(ptr);
+}
+
+/* ****************************************************************** */
+/* ********************* GRANDES ALLOCATIONS ************************ */
+/* ****************************************************************** */
+
+// Une grande allocation dispose de son propre mappage, qui est rendu au système lors de sa libération
+Test(my_secmalloc, test_mapped_01) {
+	const char *test_name = "test_mapped_01";
+	size_t malloc_size = 2 * MMAP_THRESHOLD_DEFAULT;
+
+	create_and_test_memory_allocation(test_name, 1);
+	size_t data_pool_size = arenas[0].data_pool_size;
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	struct meta_information *metadata_of_ptr = pointer_index_find(ptr);
+	cr_assert(metadata_of_ptr != NULL && metadata_of_ptr->status == MAPPED && metadata_of_ptr->size == malloc_size
+			&& metadata_of_ptr->prev == NULL && metadata_of_ptr->next == NULL,
+			"%s : la grande allocation aurait dû être représentée par un bloc de métadonnées MAPPED hors de la liste chaînée", test_name);
+
+	cr_assert((size_t) ptr % get_page_size() == 0 && arenas[0].data_pool_size == data_pool_size
+			&& ((size_t) ptr < (size_t) arenas[0].data_pool || (size_t) ptr >= (size_t) arenas[0].data_pool + DATA_POOL_RESERVED_SIZE),
+			"%s : la grande allocation n'aurait pas dû être découpée dans le pool de data", test_name);
+
+	memset(ptr, 't', malloc_size);
+	my_free(ptr);
+
+	cr_assert(metadata_of_ptr->status == UNUSED, "%s : le bloc de métadonnées aurait dû redevenir inutilisé", test_name);
+	// int msync(void *addr, size_t length, int flags); échoue (ENOMEM) si la zone n'est pas mappée
+	cr_assert(msync(ptr, get_page_size(), MS_ASYNC) == -1, "%s : le mappage aurait dû être rendu au système", test_name);
+}
+
+// Le seuil des grandes allocations est indiqué par la variable d'environnement MSM_MMAP_THRESHOLD,
+// et une grande allocation redimensionnée conserve son contenu
+Test(my_secmalloc, test_mapped_02) {
+	const char *test_name = "test_mapped_02";
+	setenv("MSM_MMAP_THRESHOLD", "1000", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, 1000);
+	byte *ptr2 = create_and_test_memory_allocation(test_name, 1001);
+	cr_assert(pointer_index_find(ptr1)->status == BUSY && pointer_index_find(ptr2)->status == MAPPED,
+			"%s : seules les allocations de plus de 1000 octets auraient dû disposer de leur propre mappage", test_name);
+
+	memset(ptr2, 't', 1001);
+	byte *ptr3 = my_realloc(ptr2, 2000);
+	cr_assert(ptr3 == ptr2 && pointer_index_find(ptr3)->size == 2000,
+			"%s : le mappage contient assez de pages, la grande allocation aurait dû être redimensionnée sur place", test_name);
+
+	byte *ptr4 = my_realloc(ptr3, 500);
+	cr_assert(ptr4 != ptr3 && pointer_index_find(ptr4)->status == BUSY,
+			"%s : la grande allocation réduite sous le seuil aurait dû être déplacée dans le pool de data", test_name);
+	for (size_t i = 0; i < 500; i++)
+		cr_assert(ptr4[i] == 't', "%s : le contenu de l'allocation n'a pas été conservé", test_name);
+}
+
+// Détection de l’overflow d'une grande allocation lors de sa libération
+Test(my_secmalloc, test_mapped_03, .exit_code = EXIT_FAILURE) {
+	const char *test_name = "test_mapped_03";
+	size_t malloc_size = 2 * MMAP_THRESHOLD_DEFAULT;
+
 	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
 	ptr[malloc_size] = 't';
 	my_free(ptr);
 }
 
+// Le seuil des grandes allocations est borné, et une taille proche de SIZE_MAX n'est jamais arrondie à une petite taille
+Test(my_secmalloc, test_mapped_04) {
+	const char *test_name = "test_mapped_04";
+	setenv("MSM_MMAP_THRESHOLD", "18446744073709551615", 1);
+
+	create_and_test_memory_allocation(test_name, 1);
+	cr_assert(mmap_threshold == MMAP_THRESHOLD_MAX, "%s : le seuil aurait dû être ramené à MMAP_THRESHOLD_MAX (%lu)", test_name, mmap_threshold);
+	cr_assert(my_malloc(SIZE_MAX - 4) == NULL, "%s : l'allocation de SIZE_MAX - 4 octets aurait dû échouer", test_name);
+
+	// Même sans borne, l'arrondi de la taille ne doit pas dépasser la valeur maximale d'un size_t
+	mmap_threshold = SIZE_MAX;
+	errno = 0;
+	cr_assert(my_malloc(SIZE_MAX - 4) == NULL && errno == ENOMEM, "%s : l'allocation aurait dû échouer (ENOMEM)", test_name);
+	errno = 0;
+	cr_assert(my_realloc(my_malloc(10), SIZE_MAX - 4) == NULL && errno == ENOMEM, "%s : le redimensionnement aurait dû échouer (ENOMEM)", test_name);
+	void *ptr = NULL;
+	cr_assert(my_posix_memalign(&ptr, 64, SIZE_MAX - 4) == ENOMEM && ptr == NULL,
+			"%s : l'allocation alignée aurait dû échouer (ENOMEM)", test_name);
+}
+
+/* ****************************************************************** */
+/* ********************* ALLOCATIONS ALIGNÉES *********************** */
+/* ****************************************************************** */
+
+// Un bloc aligné est découpé dans le pool de data : l'espace qui précède l'adresse alignée reste un bloc libre
+Test(my_secmalloc, test_aligned_01) {
+	const char *test_name = "test_aligned_01";
+	size_t alignments[] = { 64, 4096, 2 * MMAP_THRESHOLD_DEFAULT };
+	size_t sizes[] = { 100, 3 * MMAP_THRESHOLD_DEFAULT };
+
+	create_and_test_memory_allocation(test_name, 1);
+	for (size_t i = 0; i < sizeof(alignments) / sizeof(alignments[0]); i++) {
+		for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); j++) {
+			byte *ptr = my_aligned_alloc(alignments[i], sizes[j]);
+			cr_assert(ptr != NULL && (size_t) ptr % alignments[i] == 0,
+					"%s : my_aligned_alloc(%lu, %lu) aurait dû renvoyer une adresse alignée", test_name, alignments[i], sizes[j]);
+			cr_assert(my_malloc_usable_size(ptr) >= sizes[j] && my_malloc_usable_size(ptr) < sizes[j] + ALLOCATION_ALIGNMENT,
+					"%s : taille utilisable incorrecte", test_name);
+			memset(ptr, 't', sizes[j]);
+
+			struct meta_information *metadata_of_ptr = pointer_index_find(ptr);
+			if (metadata_of_ptr->status == BUSY)
+				cr_assert(metadata_of_ptr->prev->status == FREE || metadata_of_ptr->prev->data_ptr == arenas[0].data_pool,
+						"%s : l'espace qui précède le bloc aligné aurait dû former un bloc libre", test_name);
+		}
+	}
+
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû rester cohérent", test_name);
+}
+
+// Alignements invalides, dépassement de capacité de my_reallocarray() et taille utilisable d'un pointeur inconnu
+Test(my_secmalloc, test_aligned_02) {
+	const char *test_name = "test_aligned_02";
+	void *ptr = NULL;
+
+	cr_assert(my_posix_memalign(&ptr, 24, 100) == EINVAL && my_posix_memalign(&ptr, 4, 100) == EINVAL,
+			"%s : un alignement qui n'est pas une puissance de 2 multiple de sizeof(void *) aurait dû être refusé", test_name);
+	cr_assert(my_posix_memalign(&ptr, 256, 100) == 0 && (size_t) ptr % 256 == 0, "%s : my_posix_memalign() aurait dû réussir", test_name);
+
+	byte *ptr2 = my_memalign(48, 10);
+	cr_assert(ptr2 != NULL && (size_t) ptr2 % 64 == 0, "%s : l'alignement de my_memalign() aurait dû être arrondi à 64", test_name);
+	cr_assert(my_malloc_usable_size(ptr2 + 1) == 0, "%s : un pointeur inconnu n'a pas de taille utilisable", test_name);
+
+	byte *ptr3 = my_pvalloc(10);
+	cr_assert(ptr3 != NULL && (size_t) ptr3 % get_page_size() == 0 && my_malloc_usable_size(ptr3) >= get_page_size(),
+			"%s : my_pvalloc() aurait dû allouer une page entière", test_name);
+
+	errno = 0;
+	cr_assert(my_reallocarray(ptr, SIZE_MAX / 2, 3) == NULL && errno == ENOMEM && my_malloc_usable_size(ptr) == ALIGN_SIZE(100),
+			"%s : my_reallocarray() aurait dû échouer sans modifier le bloc d'origine", test_name);
+
+	my_free(ptr);
+	my_free(ptr2);
+	my_free(ptr3);
+}
+
+/* ****************************************************************** */
+/* ******************* ALLOCATIONS ÉCHANTILLONNÉES ****************** */
+/* ****************************************************************** */
+
+// Une allocation sur MSM_GUARD_SAMPLE_RATE est placée contre une page de garde, hors du pool de data
+Test(my_secmalloc, test_guard_01) {
+	const char *test_name = "test_guard_01";
+	size_t malloc_size = 96; // Multiple de ALLOCATION_ALIGNMENT : les données touchent la page de garde
+	setenv("MSM_GUARD_SAMPLE_RATE", "2", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size);
+	struct meta_information *metadata_of_ptr2 = pointer_index_find(ptr2);
+
+	cr_assert(pointer_index_find(ptr1)->status == BUSY && metadata_of_ptr2->status == GUARDED,
+			"%s : seule la deuxième allocation aurait dû être échantillonnée", test_name);
+	cr_assert(((size_t) ptr2 + malloc_size) % get_page_size() == 0 && (byte*) ptr2 >= (byte*) guard_pool.slots
+			&& (byte*) ptr2 < (byte*) guard_pool.slots + GUARD_POOL_SLOTS_NB * 2 * get_page_size(),
+			"%s : l'allocation échantillonnée aurait dû être placée contre une page de garde du pool", test_name);
+
+	memset(ptr2, 't', malloc_size);
+	my_free(ptr2);
+	cr_assert(metadata_of_ptr2->status == UNUSED && guard_pool.used_slots[0] == 0,
+			"%s : l'emplacement et le bloc de métadonnées auraient dû être libérés", test_name);
+}
+
+// Un overflow d'une allocation échantillonnée est détecté à l'instruction fautive
+Test(my_secmalloc, test_guard_02, .signal = SIGSEGV) {
+	const char *test_name = "test_guard_02";
+	size_t malloc_size = 96; // Multiple de ALLOCATION_ALIGNMENT : les données touchent la page de garde
+	setenv("MSM_GUARD_SAMPLE_RATE", "1", 1);
+
+	volatile byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	ptr[malloc_size] = 't';
+}
+
+// Un overflow qui reste avant la page de garde (taille qui n'est pas un multiple de ALLOCATION_ALIGNMENT) est détecté
+// par la vérification du motif qui sépare les données de la page de garde
+Test(my_secmalloc, test_guard_03, .exit_code = EXIT_FAILURE) {
+	const char *test_name = "test_guard_03";
+	size_t malloc_size = 90;
+	setenv("MSM_GUARD_SAMPLE_RATE", "1", 1);
+	setenv("MSM_SCAN_INTERVAL_MS", "60000", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	cr_assert(pointer_index_find(ptr)->status == GUARDED && ((size_t) ptr + malloc_size) % get_page_size() != 0,
+			"%s : l'allocation aurait dû être échantillonnée, à moins de ALLOCATION_ALIGNMENT octets de la page de garde", test_name);
+	cr_assert(secmalloc_check() == 0, "%s : le tas aurait dû être intact", test_name);
+
+	ptr[malloc_size] = 't';
+	cr_assert(secmalloc_check() == 1, "%s : secmalloc_check() aurait dû détecter l'overflow", test_name);
+	my_free(ptr);
+}
+
+/* ****************************************************************** */
+/* *********************** NETTOYAGE DIFFÉRÉ ************************ */
+/* ****************************************************************** */
+
+// Un grand bloc libéré n'est réutilisable qu'après son nettoyage par le thread de nettoyage différé
+Test(my_secmalloc, test_deferred_wipe_01) {
+	const char *test_name = "test_deferred_wipe_01";
+	size_t malloc_size = 5000;
+	setenv("MSM_DEFERRED_WIPE", "4096", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	create_and_test_memory_allocation(test_name, 12);
+	struct meta_information *metadata_of_ptr1 = pointer_index_find(ptr1);
+
+	memset(ptr1, 't', malloc_size);
+	my_free(ptr1);
+
+	// Le nettoyage est effectué en arrière-plan
+	for (size_t i = 0; i < 100 && __atomic_load_n(&(metadata_of_ptr1->status), __ATOMIC_ACQUIRE) == WIPING; i++)
+		usleep(10000);
+
+	spinlock_lock(&(metadata_of_ptr1->lock));
+	cr_assert(metadata_of_ptr1->status == FREE, "%s : le bloc aurait dû être rendu au tas après son nettoyage", test_name);
+	for (size_t i = 0; i < malloc_size; i++)
+		cr_assert(ptr1[i] == 0, "%s : le bloc n'a pas été nettoyé", test_name);
+	spinlock_unlock(&(metadata_of_ptr1->lock));
+
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size);
+	cr_assert(ptr2 == ptr1, "%s : le bloc nettoyé aurait dû être réutilisé", test_name);
+}
+
+// Détection d'un double free lorsque le bloc est en attente de nettoyage (ou vient d'être nettoyé)
+Test(my_secmalloc, test_deferred_wipe_02, .signal = SIGUSR1) {
+	const char *test_name = "test_deferred_wipe_02";
+	size_t malloc_size = 5000;
+	setenv("MSM_DEFERRED_WIPE", "4096", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	my_free(ptr);
+	my_free(ptr);
+}
+
+/* ****************************************************************** */
+/* ********************* CACHE PAR THREAD *************************** */
+/* ****************************************************************** */
+
+// Un bloc libéré est conservé dans le cache du thread (après nettoyage) puis réutilisé
+Test(my_secmalloc, test_thread_cache_01) {
+	const char *test_name = "test_thread_cache_01";
+	size_t malloc_size = 40;
+	setenv("MSM_THREAD_CACHE", "4", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+	memset(ptr1, 't', malloc_size);
+	struct meta_information *metadata_of_ptr1 = get_and_test_meta_info_of_memory_allocation(test_name, ptr1, malloc_size);
+	my_free(ptr1);
+
+	cr_assert(metadata_of_ptr1->status == CACHED, "%s : le bloc libéré aurait dû être conservé dans le cache du thread", test_name);
+	for (size_t i = 0; i < malloc_size; i++)
+		cr_assert(ptr1[i] == 0, "%s : le bloc conservé dans le cache du thread n'a pas été nettoyé", test_name);
+
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size - 1);
+	cr_assert(ptr2 == ptr1, "%s : le bloc conservé dans le cache du thread aurait dû être réutilisé ptr2 %lx != ptr1 %lx",
+			test_name, (size_t) ptr2, (size_t) ptr1);
+}
+
+// Détection d'un double free lorsque le bloc se trouve dans le cache du thread
+Test(my_secmalloc, test_thread_cache_02, .signal = SIGUSR1) {
+	const char *test_name = "test_thread_cache_02";
+	size_t malloc_size = 40;
+	setenv("MSM_THREAD_CACHE", "4", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	my_free(ptr);
+	my_free(ptr);
+}
+
+void *allocation_and_free_thread(void *arg) {
+	size_t malloc_size = *((size_t*) arg);
+	byte *ptr = my_malloc(malloc_size);
+	my_free(ptr);
+
+	pthread_exit((void *) ptr);
+}
+
+// Le cache d'un thread est rendu au tas à la fin du thread
+Test(my_secmalloc, test_thread_cache_03) {
+	const char *test_name = "test_thread_cache_03";
+	size_t malloc_size = 40;
+	setenv("MSM_THREAD_CACHE", "4", 1);
+
+	pthread_t thread;
+	int pthread_create_result = pthread_create(&thread, NULL, allocation_and_free_thread, (void*) &malloc_size);
+	if (pthread_create_result != 0)
+		cr_assert(0, "%s : Echec de la fonction pthread_create()", test_name);
+
+	byte *ptr = NULL;
+	int pthread_join_result = pthread_join(thread, (void **) &ptr);
+	if (pthread_join_result != 0)
+		cr_assert(0, "%s : Echec de la fonction pthread_join()", test_name);
+
+	size_t size_after = get_page_size() - sizeof(struct struct_canary);
+	struct meta_information* item = metadata_arenas_map(is_meta_information_of_free_memory, (void*) &size_after);
+	cr_assert(item != NULL && item->data_ptr == (void*) ptr, "%s : Une fois le thread terminé, le bloc conservé dans son cache "
+			"aurait dû être rendu au tas et fusionné avec le reste du pool de data", test_name);
+}
+
+// Avec le cache du thread, les paires my_free() / my_malloc() d'un thread ne prennent aucun verrou de l'index des pointeurs
+// (ils sont tous détenus par le test : sinon, le test reste bloqué jusqu'à SIGALRM)
+Test(my_secmalloc, test_thread_cache_04) {
+	const char *test_name = "test_thread_cache_04";
+	size_t malloc_size1 = 40;
+	size_t malloc_size2 = 100;
+	setenv("MSM_THREAD_CACHE", "4", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size1);
+	byte *ptr2 = create_and_test_memory_allocation(test_name, malloc_size2);
+
+	// unsigned int alarm(unsigned int seconds);
+	alarm(10);
+	for (size_t i = 0; i < POINTER_INDEX_MUTEXES_NB; i++)
+		mutex_lock(&(pointer_index.mutexes[i]));
+
+	int same_blocks = 1;
+	for (size_t i = 0; i < 1000; i++) {
+		my_free(ptr1);
+		my_free(ptr2);
+		same_blocks &= (my_malloc(malloc_size2) == ptr2 && my_malloc(malloc_size1) == ptr1);
+	}
+
+	for (size_t i = 0; i < POINTER_INDEX_MUTEXES_NB; i++)
+		mutex_unlock(&(pointer_index.mutexes[i]));
+	alarm(0);
+
+	cr_assert(same_blocks, "%s : les blocs conservés dans le cache du thread auraient dû être réutilisés", test_name);
+	cr_assert(pointer_index_find(ptr1) != NULL && pointer_index_find(ptr2) != NULL,
+			"%s : les blocs réutilisés auraient dû rester dans l'index des pointeurs", test_name);
+}
+
+/* ****************************************************************** */
+/* **************************** ARÈNES ****************************** */
+/* ****************************************************************** */
+
+void *arena_allocation_thread(void *arg) {
+	size_t malloc_size = *((size_t*) arg);
+	byte *ptr = my_malloc(malloc_size);
+
+	pthread_exit((void *) ptr);
+}
+
+// Un second thread alloue dans une autre arène que le thread principal,
+// et un bloc libéré par un autre thread est rendu à l'arène à laquelle il appartient
+Test(my_secmalloc, test_arenas_01) {
+	const char *test_name = "test_arenas_01";
+	size_t malloc_size = 40;
+	setenv("MSM_ARENAS", "2", 1);
+
+	byte *ptr1 = create_and_test_memory_allocation(test_name, malloc_size);
+
+	pthread_t thread;
+	int pthread_create_result = pthread_create(&thread, NULL, arena_allocation_thread, (void*) &malloc_size);
+	if (pthread_create_result != 0)
+		cr_assert(0, "%s : Echec de la fonction pthread_create()", test_name);
+
+	byte *ptr2 = NULL;
+	int pthread_join_result = pthread_join(thread, (void **) &ptr2);
+	if (pthread_join_result != 0)
+		cr_assert(0, "%s : Echec de la fonction pthread_join()", test_name);
+
+	my_malloc_should_not_return_null(test_name, ptr2, malloc_size);
+	struct meta_information *metadata_of_ptr1 = get_and_test_meta_info_of_memory_allocation(test_name, ptr1, malloc_size);
+	struct meta_information *metadata_of_ptr2 = get_and_test_meta_info_of_memory_allocation(test_name, ptr2, malloc_size);
+
+	cr_assert(metadata_of_ptr1->arena == &arenas[0] && metadata_of_ptr2->arena == &arenas[1],
+			"%s : Le thread principal et le second thread devraient utiliser deux arènes différentes", test_name);
+	cr_assert(ptr2 == (byte *) arenas[1].data_pool, "%s : La mémoire allouée par le second thread devrait se trouver "
+			"au début du pool de data de la seconde arène", test_name);
+
+	my_free(ptr2);
+	size_t size_after = get_page_size() - sizeof(struct struct_canary);
+	cr_assert(arenas[1].meta_information_pool_root->status == FREE && arenas[1].meta_information_pool_root->size == size_after,
+			"%s : Le bloc libéré par le thread principal aurait dû être rendu à la seconde arène", test_name);
+}
+
+/* ****************************************************************** */
+/* ********************** JOURNAL ASYNCHRONE ************************ */
+/* ****************************************************************** */
+
+// Les messages sont écrits dans le fichier des logs sous forme d'enregistrements binaires, chaque chaîne
+// de format étant définie avant le premier message qui l'utilise
+Test(my_secmalloc, test_log_01) {
+	const char *test_name = "test_log_01";
+	const char *logs_file_path = "/tmp/msm_test_log_01";
+	size_t malloc_size = 1234;
+	unlink(logs_file_path);
+	setenv("MSM_OUPUT", logs_file_path, 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, malloc_size);
+	my_free(ptr);
+	log_flush();
+
+	static char logs[LOG_FLUSH_BUFFER_SIZE];
+	int file_descriptor = open(logs_file_path, O_RDONLY);
+	cr_assert(file_descriptor != -1, "%s : le fichier des logs aurait dû être créé", test_name);
+	ssize_t logs_size = read(file_descriptor, logs, sizeof(logs));
+	close(file_descriptor);
+
+	uint64_t formats[LOG_KNOWN_FORMATS_NB];
+	size_t formats_nb = 0, messages_nb = 0;
+	int malloc_message_found = 0;
+	ssize_t offset = 0;
+	while (offset < logs_size) {
+		struct log_record *record = (struct log_record *) (logs + offset);
+		cr_assert(record->size >= sizeof(struct log_record) && record->size % sizeof(uint64_t) == 0 && offset + record->size <= logs_size,
+				"%s : enregistrement invalide à l'offset %ld", test_name, offset);
+
+		if (record->type == LOG_RECORD_FORMAT) {
+			cr_assert(strcmp((char *) record + sizeof(struct log_record), (char *) (size_t) record->format) == 0,
+					"%s : le texte de la chaîne de format aurait dû suivre l'en-tête", test_name);
+			formats[formats_nb++] = record->format;
+		} else if (record->type == LOG_RECORD_MESSAGE) {
+			int format_defined = 0;
+			for (size_t i = 0; i < formats_nb; i++)
+				format_defined |= (formats[i] == record->format);
+			cr_assert(format_defined, "%s : la chaîne de format aurait dû être définie avant le message", test_name);
+
+			uint64_t first_argument = *((uint64_t *) ((char *) record + sizeof(struct log_record)));
+			if (strcmp((char *) (size_t) record->format, "my_malloc(%lu) \n") == 0 && first_argument == malloc_size)
+				malloc_message_found = 1;
+			messages_nb++;
+		}
+
+		offset += record->size;
+	}
+
+	cr_assert(messages_nb > formats_nb && malloc_message_found,
+			"%s : le message de l'appel my_malloc(%lu) aurait dû être écrit dans le fichier des logs", test_name, malloc_size);
+	unlink(logs_file_path);
+}
+
+// Avec MSM_LOG_LEVEL=info, seuls les messages d'initialisation sont écrits, et non ceux de chaque allocation
+Test(my_secmalloc, test_log_02) {
+	const char *test_name = "test_log_02";
+	const char *logs_file_path = "/tmp/msm_test_log_02";
+	unlink(logs_file_path);
+	setenv("MSM_OUPUT", logs_file_path, 1);
+	setenv("MSM_LOG_LEVEL", "info", 1);
+
+	my_free(create_and_test_memory_allocation(test_name, 1234));
+	log_flush();
+	cr_assert(log_level == LOG_LEVEL_INFO, "%s : le niveau du journal aurait dû être LOG_LEVEL_INFO", test_name);
+
+	static char logs[LOG_FLUSH_BUFFER_SIZE];
+	int file_descriptor = open(logs_file_path, O_RDONLY);
+	ssize_t logs_size = read(file_descriptor, logs, sizeof(logs));
+	close(file_descriptor);
+
+	int init_message_found = 0, malloc_message_found = 0;
+	for (ssize_t offset = 0; offset < logs_size; offset += ((struct log_record *) (logs + offset))->size) {
+		struct log_record *record = (struct log_record *) (logs + offset);
+		if (record->type != LOG_RECORD_MESSAGE)
+			continue;
+
+		init_message_found |= (strncmp((char *) (size_t) record->format, "Initialisation de l'arene", 25) == 0);
+		malloc_message_found |= (strncmp((char *) (size_t) record->format, "my_malloc(", 10) == 0);
+	}
+
+	cr_assert(init_message_found && !malloc_message_found,
+			"%s : seuls les messages de niveau LOG_LEVEL_INFO auraient dû être écrits", test_name);
+	unlink(logs_file_path);
+}
+
+// Enregistrement des allocations (MSM_TRACE) : les appels sont ajoutés au journal par les fonctions de la bibliothèque dynamique
+Test(my_secmalloc, test_trace_01) {
+	const char *test_name = "test_trace_01";
+	const char *logs_file_path = "/tmp/msm_test_trace_01";
+	size_t realloc_size = 4321;
+	unlink(logs_file_path);
+	setenv("MSM_OUPUT", logs_file_path, 1);
+	setenv("MSM_TRACE", "1", 1);
+
+	byte *ptr = create_and_test_memory_allocation(test_name, 1234);
+	cr_assert(trace_enabled, "%s : l'enregistrement des allocations aurait dû être activé", test_name);
+
+	uint64_t timestamp = get_timestamp();
+	trace_operation(TRACE_REALLOC, ptr, 0, realloc_size, ptr, timestamp);
+	my_free(ptr);
+	log_flush();
+
+	static char logs[LOG_FLUSH_BUFFER_SIZE];
+	int file_descriptor = open(logs_file_path, O_RDONLY);
+	ssize_t logs_size = read(file_descriptor, logs, sizeof(logs));
+	close(file_descriptor);
+
+	int trace_record_found = 0;
+	for (ssize_t offset = 0; offset < logs_size; offset += ((struct log_record *) (logs + offset))->size) {
+		struct trace_record *record = (struct trace_record *) (logs + offset);
+		if (record->header.type != LOG_RECORD_TRACE)
+			continue;
+
+		cr_assert(record->header.size == sizeof(struct trace_record), "%s : taille d'enregistrement invalide", test_name);
+		trace_record_found |= (record->operation == TRACE_REALLOC && record->thread == 1 && record->header.timestamp == timestamp
+				&& record->ptr == (uint64_t) (size_t) ptr && record->size == realloc_size && record->result == (uint64_t) (size_t) ptr);
+	}
+
+	cr_assert(trace_record_found, "%s : l'appel à realloc() aurait dû être enregistré dans le fichier des logs", test_name);
+	unlink(logs_file_path);
+}
+
+// Les appels de la bibliothèque dynamique sont enregistrés : tools/msm_replay rejoue une trace écrite par le test
+// avec libmy_secmalloc.so (compilée par make build_test) chargée par LD_PRELOAD, et ses appels réels sont décodés
+Test(my_secmalloc, test_trace_02) {
+	const char *test_name = "test_trace_02";
+	const char *input_file_path = "/tmp/msm_test_trace_02_input";
+	const char *logs_file_path = "/tmp/msm_test_trace_02";
+	const char *output_file_path = "/tmp/msm_test_trace_02_output";
+	cr_assert(access("./libmy_secmalloc.so", R_OK) == 0 && access("tools/msm_replay", X_OK) == 0,
+			"%s : libmy_secmalloc.so et tools/msm_replay auraient dû être compilés par make build_test", test_name);
+	unlink(logs_file_path);
+
+	// malloc(1000) -> 0x1000, realloc(0x1000, 3000) -> 0x2000, calloc(7, 9) -> 0x3000, free(0x2000), free(0x3000)
+	struct trace_record input[5] = {
+		{ .operation = TRACE_MALLOC, .size = 1000, .result = 0x1000 },
+		{ .operation = TRACE_REALLOC, .ptr = 0x1000, .size = 3000, .result = 0x2000 },
+		{ .operation = TRACE_CALLOC, .count = 7, .size = 9, .result = 0x3000 },
+		{ .operation = TRACE_FREE, .ptr = 0x2000 },
+		{ .operation = TRACE_FREE, .ptr = 0x3000 },
+	};
+	for (size_t i = 0; i < 5; i++) {
+		input[i].header.size = sizeof(struct trace_record);
+		input[i].header.type = LOG_RECORD_TRACE;
+		input[i].header.timestamp = i + 1;
+		input[i].thread = 1;
+	}
+	int file_descriptor = open(input_file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	cr_assert(write(file_descriptor, input, sizeof(input)) == sizeof(input), "%s : échec de l'écriture de la trace", test_name);
+	close(file_descriptor);
+
+	// L'environnement de msm_replay ne contient que les variables nécessaires (les appels du test ne sont pas enregistrés)
+	pid_t pid = fork();
+	if (pid == 0) {
+		char logs_env[64], *argv[] = { "tools/msm_replay", (char *) input_file_path, NULL };
+		snprintf(logs_env, sizeof(logs_env), "MSM_OUPUT=%s", logs_file_path);
+		char *envp[] = { "LD_PRELOAD=./libmy_secmalloc.so", "MSM_TRACE=1", logs_env, NULL };
+
+		int output_file_descriptor = open(output_file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		dup2(output_file_descriptor, STDOUT_FILENO);
+		execve(argv[0], argv, envp);
+		_exit(127);
+	}
+	int status;
+	waitpid(pid, &status, 0);
+	cr_assert(WIFEXITED(status) && WEXITSTATUS(status) == 0, "%s : msm_replay aurait dû se terminer normalement", test_name);
+
+	char output[1024] = { 0 };
+	file_descriptor = open(output_file_path, O_RDONLY);
+	cr_assert(read(file_descriptor, output, sizeof(output) - 1) > 0, "%s : msm_replay n'a rien écrit", test_name);
+	close(file_descriptor);
+	cr_assert(strstr(output, "\"operations\": 5,") != NULL, "%s : msm_replay aurait dû rejouer 5 appels : %s", test_name, output);
+
+	static char logs[1 << 20];
+	ssize_t logs_size = 0, read_size;
+	file_descriptor = open(logs_file_path, O_RDONLY);
+	while ((read_size = read(file_descriptor, logs + logs_size, sizeof(logs) - logs_size)) > 0)
+		logs_size += read_size;
+	close(file_descriptor);
+
+	// Les appels rejoués sont retrouvés parmi ceux de msm_replay (lecture de la trace, table de hachage, ...)
+	uint64_t malloc_result = 0, realloc_result = 0, calloc_result = 0;
+	int realloc_found = 0, free_realloc_found = 0, free_calloc_found = 0;
+	for (ssize_t offset = 0; offset < logs_size; offset += ((struct log_record *) (logs + offset))->size) {
+		struct trace_record *record = (struct trace_record *) (logs + offset);
+		cr_assert(record->header.size >= sizeof(struct log_record), "%s : enregistrement invalide à l'offset %ld", test_name, offset);
+		if (record->header.type != LOG_RECORD_TRACE)
+			continue;
+
+		if (record->operation == TRACE_MALLOC && record->size == 1000 && malloc_result == 0)
+			malloc_result = record->result;
+		else if (record->operation == TRACE_REALLOC && malloc_result != 0 && record->ptr == malloc_result && record->size == 3000) {
+			realloc_found = 1;
+			realloc_result = record->result;
+		} else if (record->operation == TRACE_CALLOC && record->count == 7 && record->size == 9)
+			calloc_result = record->result;
+		else if (record->operation == TRACE_FREE && realloc_result != 0 && record->ptr == realloc_result)
+			free_realloc_found = 1;
+		else if (record->operation == TRACE_FREE && calloc_result != 0 && record->ptr == calloc_result)
+			free_calloc_found = 1;
+	}
+
+	cr_assert(malloc_result != 0 && realloc_found && calloc_result != 0 && free_realloc_found && free_calloc_found,
+			"%s : les appels à malloc(), realloc(), calloc() et free() rejoués auraient dû être enregistrés "
+			"(malloc %d, realloc %d, calloc %d, free %d %d)", test_name, malloc_result != 0, realloc_found,
+			calloc_result != 0, free_realloc_found, free_calloc_found);
+
+	unlink(input_file_path);
+	unlink(logs_file_path);
+	unlink(output_file_path);
+}
+
 /* ****************************************************************** */
 /* ********************* MULTITHREADING ***************************** */
 /* ****************************************************************** */
@@ -557,6 +1850,6 @@ Test(my_secmalloc, test_multithreading_02) {
 	}
 
 	size_t size_after = get_page_size() - sizeof(struct struct_canary);
-	struct meta_information* item = metadata_linked_list_map(meta_information_pool_root, 1, is_meta_information_of_free_memory, (void*) &size_after, 1);
+	struct meta_information* item = metadata_arenas_map(is_meta_information_of_free_memory, (void*) &size_after);
 	cr_assert(item != NULL, "Une fois toutes les allocations de memoire liberees, il devrait y avoir un bloc de taille %lu", size_after);
 }
@@ -0,0 +1,160 @@
+/*
+ * msm_logdump : reconstitue le texte des messages d'un fichier des logs écrit par le journal asynchrone
+ * (variable d'environnement MSM_OUPUT). Les messages de tous les threads sont affichés dans l'ordre chronologique.
+ *
+ * Utilisation : msm_logdump [fichier des logs]  (l'entrée standard est lue si aucun fichier n'est indiqué)
+ */
+#include <stdio.h> // printf(), snprintf(), fopen(), fread()
+#include <stdlib.h> // malloc(), realloc(), qsort(), EXIT_FAILURE
+#include <string.h> // memcpy(), strchr()
+#include "my_secmalloc.private.h"
+
+struct message {
+	const struct log_record *record;
+	size_t file_offset; // Pour conserver l'ordre du fichier entre deux messages de même date
+};
+
+struct format {
+	uint64_t format;
+	const char *text;
+};
+
+int compare_messages(const void *a, const void *b) {
+	const struct message *message_a = a;
+	const struct message *message_b = b;
+
+	if (message_a->record->timestamp != message_b->record->timestamp)
+		return (message_a->record->timestamp < message_b->record->timestamp) ? -1 : 1;
+	return (message_a->file_offset < message_b->file_offset) ? -1 : 1;
+}
+
+const char *find_format(const struct format *formats, size_t formats_nb, uint64_t format) {
+	// Une même chaîne de format peut être définie plusieurs fois : la dernière définition est utilisée
+	for (size_t i = formats_nb; i > 0; i--) {
+		if (formats[i - 1].format == format)
+			return formats[i - 1].text;
+	}
+	return NULL;
+}
+
+/**
+ * La fonction print_message() affiche le texte d'un message : chaque indicateur de conversion de la chaîne
+ * de format est mis en forme avec snprintf() et la valeur correspondante de l'enregistrement.
+ */
+void print_message(const struct log_record *record, const char *string_format) {
+	const char *argument = (const char *) record + sizeof(struct log_record);
+	const char *record_end = (const char *) record + record->size;
+
+	for (const char *c = string_format; *c != '\0'; c++) {
+		if (*c != '%') {
+			putchar(*c);
+			continue;
+		}
+
+		const char *conversion_start = c;
+		int long_argument = 0;
+		for (c++; *c != '\0' && strchr("-+ #0123456789.lzh", *c) != NULL; c++)
+			long_argument |= (*c == 'l' || *c == 'z');
+
+		if (*c == '\0')
+			break;
+		if (*c == '%') {
+			putchar('%');
+			continue;
+		}
+
+		char conversion[32];
+		size_t conversion_size = (size_t) (c - conversion_start) + 1;
+		if (conversion_size >= sizeof(conversion) || argument + sizeof(uint64_t) > record_end) {
+			fwrite(conversion_start, 1, conversion_size, stdout);
+			continue;
+		}
+		memcpy(conversion, conversion_start, conversion_size);
+		conversion[conversion_size] = '\0';
+
+		uint64_t value;
+		memcpy(&value, argument, sizeof(value));
+		argument += sizeof(value);
+
+		if (*c == 's') {
+			printf(conversion, argument);
+			argument += (value + sizeof(uint64_t)) & ~(sizeof(uint64_t) - 1);
+		} else if (*c == 'p') {
+			printf(conversion, (void *) (size_t) value);
+		} else if (strchr("fFeEgGaA", *c) != NULL) {
+			double double_value;
+			memcpy(&double_value, &value, sizeof(value));
+			printf(conversion, double_value);
+		} else if (long_argument) {
+			printf(conversion, (unsigned long) value);
+		} else {
+			printf(conversion, (unsigned int) value);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	FILE *logs_file = (argc > 1) ? fopen(argv[1], "rb") : stdin;
+	if (logs_file == NULL) {
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	size_t logs_size = 0, logs_capacity = 1 << 20;
+	char *logs = malloc(logs_capacity);
+	size_t read_size;
+	while (logs != NULL && (read_size = fread(logs + logs_size, 1, logs_capacity - logs_size, logs_file)) > 0) {
+		logs_size += read_size;
+		if (logs_size == logs_capacity)
+			logs = realloc(logs, logs_capacity *= 2);
+	}
+
+	size_t records_nb = logs_size / sizeof(struct log_record);
+	struct message *messages = malloc((records_nb + 1) * sizeof(struct message));
+	struct format *formats = malloc((records_nb + 1) * sizeof(struct format));
+	if (logs == NULL || messages == NULL || formats == NULL) {
+		fprintf(stderr, "Memoire insuffisante\n");
+		return EXIT_FAILURE;
+	}
+
+	size_t messages_nb = 0, formats_nb = 0, offset = 0;
+	while (offset + sizeof(struct log_record) <= logs_size) {
+		const struct log_record *record = (const struct log_record *) (logs + offset);
+		if (record->size < sizeof(struct log_record) || record->size % sizeof(uint64_t) != 0 || offset + record->size > logs_size) {
+			fprintf(stderr, "Enregistrement invalide a l'offset %lu\n", offset);
+			break;
+		}
+
+		if (record->type == LOG_RECORD_FORMAT) {
+			formats[formats_nb].format = record->format;
+			formats[formats_nb].text = (const char *) record + sizeof(struct log_record);
+			formats_nb++;
+		} else if (record->type == LOG_RECORD_MESSAGE || record->type == LOG_RECORD_DROPPED) {
+			messages[messages_nb].record = record;
+			messages[messages_nb].file_offset = offset;
+			messages_nb++;
+		}
+
+		offset += record->size;
+	}
+
+	qsort(messages, messages_nb, sizeof(struct message), compare_messages);
+
+	for (size_t i = 0; i < messages_nb; i++) {
+		const struct log_record *record = messages[i].record;
+		if (record->type == LOG_RECORD_DROPPED) {
+			uint64_t dropped_nb;
+			memcpy(&dropped_nb, (const char *) record + sizeof(struct log_record), sizeof(dropped_nb));
+			printf("[%lu messages perdus] \n", (unsigned long) dropped_nb);
+			continue;
+		}
+
+		const char *string_format = find_format(formats, formats_nb, record->format);
+		if (string_format == NULL)
+			printf("[chaine de format %#lx inconnue] \n", (unsigned long) record->format);
+		else
+			print_message(record, string_format);
+	}
+
+	return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * msm_replay : rejoue les appels à malloc(), free(), calloc(), realloc() et aux fonctions d'allocation alignée
+ * enregistrés dans un fichier des logs (variables d'environnement MSM_OUPUT et MSM_TRACE, bibliothèque dynamique)
+ * et mesure le débit, la mémoire résidente maximale et la fragmentation. Le rejeu utilise l'allocateur avec lequel
+ * le programme s'exécute : celui de la glibc, ou libmy_secmalloc.so chargée avec LD_PRELOAD.
+ *
+ * Utilisation : msm_replay [-t] fichier des logs
+ *   -t : chaque thread enregistré est rejoué par un thread (par défaut, tous les appels sont rejoués par un seul thread,
+ *        dans l'ordre chronologique)
+ *
+ * Les résultats sont écrits sur la sortie standard sous la forme d'un objet JSON.
+ */
+#include <stdio.h> // printf(), fopen(), fread()
+#include <stdlib.h> // malloc(), calloc(), realloc(), free(), posix_memalign(), qsort()
+#include <string.h> // strcmp()
+#include <pthread.h> // pthread_create(), pthread_join()
+#include <sched.h> // sched_yield()
+#include <time.h> // clock_gettime()
+#include <unistd.h> // sysconf()
+#include "my_secmalloc.private.h"
+
+#define TOUCH_STEP 4096 // Un octet est écrit tous les TOUCH_STEP octets de chaque bloc alloué, pour qu'il soit résident
+#define RSS_SAMPLE_INTERVAL 4096 // Nombre d'appels rejoués entre deux mesures de la mémoire résidente
+
+// Appel à rejouer. Le pointeur libéré ou redimensionné par un appel est celui renvoyé par l'appel d'indice dependency.
+struct operation {
+	const struct trace_record *record;
+	size_t dependency; // SIZE_MAX si l'appel ne dépend d'aucun autre (ptr NULL, ou pointeur alloué avant l'enregistrement)
+	size_t size; // Taille du bloc renvoyé (0 si aucun bloc n'est renvoyé)
+	void *result; // Pointeur renvoyé lors du rejeu
+	int done;
+};
+
+struct replay_thread {
+	uint32_t thread;
+	struct operation *operations;
+	size_t operations_nb;
+	int sample_rss;
+};
+
+size_t live_bytes = 0;
+size_t peak_live_bytes = 0;
+size_t peak_rss = 0;
+size_t page_size_bytes = 4096;
+
+// Les pools sont réservés à des adresses alignées : les bits de poids faible ne suffisent pas à répartir les pointeurs
+size_t hash_ptr(uint64_t ptr, size_t buckets_nb) {
+	return (size_t) ((ptr * 0x9E3779B97F4A7C15ULL) >> 32) & (buckets_nb - 1);
+}
+
+int compare_operations(const void *a, const void *b) {
+	const struct operation *operation_a = a;
+	const struct operation *operation_b = b;
+
+	if (operation_a->record->header.timestamp != operation_b->record->header.timestamp)
+		return (operation_a->record->header.timestamp < operation_b->record->header.timestamp) ? -1 : 1;
+	return (operation_a->record < operation_b->record) ? -1 : 1;
+}
+
+size_t get_rss() {
+	size_t pages_nb = 0, resident_pages_nb = 0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm != NULL) {
+		if (fscanf(statm, "%lu %lu", &pages_nb, &resident_pages_nb) != 2)
+			resident_pages_nb = 0;
+		fclose(statm);
+	}
+	return resident_pages_nb * page_size_bytes;
+}
+
+void update_peak(size_t *peak, size_t value) {
+	size_t current_peak = __atomic_load_n(peak, __ATOMIC_RELAXED);
+	while (value > current_peak && !__atomic_compare_exchange_n(peak, &current_peak, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+void replay_operation(struct operation *operations, struct operation *operation) {
+	const struct trace_record *record = operation->record;
+	void *ptr = NULL;
+	size_t freed_size = 0;
+
+	if (operation->dependency != SIZE_MAX) {
+		struct operation *dependency = &operations[operation->dependency];
+		while (!__atomic_load_n(&(dependency->done), __ATOMIC_ACQUIRE))
+			sched_yield();
+		ptr = dependency->result;
+		freed_size = dependency->size;
+	}
+
+	switch (record->operation) {
+		case TRACE_MALLOC:
+			operation->result = malloc(record->size);
+			break;
+		case TRACE_CALLOC:
+			operation->result = calloc(record->count, record->size);
+			break;
+		case TRACE_REALLOC:
+			operation->result = realloc(ptr, record->size);
+			break;
+		case TRACE_MEMALIGN:
+			if (posix_memalign(&(operation->result), (record->count < sizeof(void *)) ? sizeof(void *) : record->count, record->size) != 0)
+				operation->result = NULL;
+			break;
+		case TRACE_FREE:
+			free(ptr);
+			break;
+	}
+
+	if (operation->result != NULL) {
+		for (size_t i = 0; i < operation->size; i += TOUCH_STEP)
+			((char *) operation->result)[i] = 1;
+	}
+
+	size_t current_live_bytes = __atomic_add_fetch(&live_bytes, operation->size - freed_size, __ATOMIC_RELAXED);
+	update_peak(&peak_live_bytes, current_live_bytes);
+	__atomic_store_n(&(operation->done), 1, __ATOMIC_RELEASE);
+}
+
+void *replay(void *arg) {
+	struct replay_thread *replay_thread = arg;
+
+	for (size_t i = 0; i < replay_thread->operations_nb; i++) {
+		struct operation *operation = &(replay_thread->operations[i]);
+		if (operation->record->thread != replay_thread->thread && replay_thread->thread != 0)
+			continue;
+
+		replay_operation(replay_thread->operations, operation);
+		if (replay_thread->sample_rss && i % RSS_SAMPLE_INTERVAL == 0)
+			update_peak(&peak_rss, get_rss());
+	}
+
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	int multithreaded = (argc > 2 && strcmp(argv[1], "-t") == 0);
+	const char *trace_file_path = argv[argc - 1];
+	if (argc < 2) {
+		fprintf(stderr, "Utilisation : %s [-t] fichier des logs\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	FILE *trace_file = fopen(trace_file_path, "rb");
+	if (trace_file == NULL) {
+		perror(trace_file_path);
+		return EXIT_FAILURE;
+	}
+
+	size_t trace_size = 0, trace_capacity = 1 << 20;
+	char *trace = malloc(trace_capacity);
+	size_t read_size;
+	while (trace != NULL && (read_size = fread(trace + trace_size, 1, trace_capacity - trace_size, trace_file)) > 0) {
+		trace_size += read_size;
+		if (trace_size == trace_capacity)
+			trace = realloc(trace, trace_capacity *= 2);
+	}
+	fclose(trace_file);
+
+	struct operation *operations = malloc((trace_size / sizeof(struct trace_record) + 1) * sizeof(struct operation));
+	if (trace == NULL || operations == NULL) {
+		fprintf(stderr, "Memoire insuffisante\n");
+		return EXIT_FAILURE;
+	}
+
+	size_t operations_nb = 0, offset = 0;
+	uint32_t threads_nb = 0;
+	while (offset + sizeof(struct log_record) <= trace_size) {
+		const struct log_record *record = (const struct log_record *) (trace + offset);
+		if (record->size < sizeof(struct log_record) || record->size % sizeof(uint64_t) != 0 || offset + record->size > trace_size) {
+			fprintf(stderr, "Enregistrement invalide a l'offset %lu\n", offset);
+			break;
+		}
+
+		if (record->type == LOG_RECORD_TRACE) {
+			operations[operations_nb].record = (const struct trace_record *) record;
+			operations[operations_nb].result = NULL;
+			operations[operations_nb].done = 0;
+			if (operations[operations_nb].record->thread > threads_nb)
+				threads_nb = operations[operations_nb].record->thread;
+			operations_nb++;
+		}
+
+		offset += record->size;
+	}
+
+	qsort(operations, operations_nb, sizeof(struct operation), compare_operations);
+
+	// Chaque pointeur libéré ou redimensionné est associé à l'appel qui l'a renvoyé
+	// (table de hachage à adressage ouvert : pointeur enregistré -> indice de l'appel)
+	size_t buckets_nb = 1;
+	while (buckets_nb < 2 * operations_nb + 2)
+		buckets_nb *= 2;
+	uint64_t *bucket_ptrs = calloc(buckets_nb, sizeof(uint64_t));
+	size_t *bucket_operations = calloc(buckets_nb, sizeof(size_t));
+	size_t conflicts_nb = 0;
+
+	for (size_t i = 0; i < operations_nb; i++) {
+		const struct trace_record *record = operations[i].record;
+		operations[i].dependency = SIZE_MAX;
+		operations[i].size = 0;
+
+		if ((record->operation == TRACE_FREE || record->operation == TRACE_REALLOC) && record->ptr != 0) {
+			size_t bucket = hash_ptr(record->ptr, buckets_nb);
+			while (bucket_ptrs[bucket] != 0 && bucket_ptrs[bucket] != record->ptr)
+				bucket = (bucket + 1) & (buckets_nb - 1);
+
+			// Un realloc() qui échoue ne libère pas ptr
+			int freed = (record->operation == TRACE_FREE || record->result != 0 || record->size == 0);
+			if (bucket_ptrs[bucket] == record->ptr && bucket_operations[bucket] != SIZE_MAX) {
+				operations[i].dependency = bucket_operations[bucket];
+				if (freed)
+					bucket_operations[bucket] = SIZE_MAX;
+			}
+		}
+
+		if (record->result != 0) {
+			operations[i].size = (record->operation == TRACE_CALLOC) ? record->count * record->size : record->size;
+
+			size_t bucket = hash_ptr(record->result, buckets_nb);
+			while (bucket_ptrs[bucket] != 0 && bucket_ptrs[bucket] != record->result)
+				bucket = (bucket + 1) & (buckets_nb - 1);
+
+			// Pointeur encore vivant : la libération a été enregistrée après l'appel qui le renvoie de nouveau
+			if (bucket_ptrs[bucket] == record->result && bucket_operations[bucket] != SIZE_MAX)
+				conflicts_nb++;
+
+			bucket_ptrs[bucket] = record->result;
+			bucket_operations[bucket] = i;
+		}
+	}
+
+	free(bucket_ptrs);
+	free(bucket_operations);
+
+	long sysconf_result = sysconf(_SC_PAGESIZE);
+	if (sysconf_result > 0)
+		page_size_bytes = (size_t) sysconf_result;
+	size_t base_rss = get_rss();
+	peak_rss = base_rss;
+
+	struct timespec start_time, end_time;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+	if (multithreaded) {
+		pthread_t *threads = malloc(threads_nb * sizeof(pthread_t));
+		struct replay_thread *replay_threads = malloc(threads_nb * sizeof(struct replay_thread));
+		for (uint32_t i = 0; i < threads_nb; i++) {
+			replay_threads[i] = (struct replay_thread) { i + 1, operations, operations_nb, i == 0 };
+			pthread_create(&threads[i], NULL, replay, &replay_threads[i]);
+		}
+		for (uint32_t i = 0; i < threads_nb; i++)
+			pthread_join(threads[i], NULL);
+	} else {
+		struct replay_thread replay_thread = { 0, operations, operations_nb, 1 };
+		replay(&replay_thread);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+	update_peak(&peak_rss, get_rss());
+
+	double elapsed_time = (double) (end_time.tv_sec - start_time.tv_sec) + (double) (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+	size_t allocator_peak_rss = peak_rss - base_rss;
+
+	// Fragmentation : part de la mémoire résidente ajoutée par le rejeu qui ne contient pas de données vivantes
+	// (la mémoire résidente maximale et le maximum d'octets vivants ne sont pas forcément atteints au même moment)
+	double fragmentation = (allocator_peak_rss > peak_live_bytes) ? 1.0 - (double) peak_live_bytes / (double) allocator_peak_rss : 0;
+
+	printf("{\"operations\": %lu, \"threads\": %u, \"multithreaded\": %s, \"seconds\": %.6f, \"ops_per_second\": %.0f, "
+			"\"peak_live_bytes\": %lu, \"peak_rss_bytes\": %lu, \"fragmentation\": %.4f, \"conflicts\": %lu}\n",
+			operations_nb, threads_nb, multithreaded ? "true" : "false", elapsed_time,
+			(elapsed_time > 0) ? (double) operations_nb / elapsed_time : 0,
+			peak_live_bytes, allocator_peak_rss, fragmentation, conflicts_nb);
+
+	return 0;
+}